@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+
+using namespace tfe::core;
+
+// Whole seeded games under the autoplay policy (depth 12, hard budget every move) and under the
+// time manager (AISolver::planSearch), same seeds. Reports time per game, score and max tile.
+struct GameResult {
+    double seconds = 0;
+    long long moves = 0;
+    int score = 0;
+    int maxTile = 0;
+};
+
+template <typename Policy>
+static GameResult playGame(const uint64_t seed, Policy&& policy) {
+    Board board(4, seed);
+    GameResult result;
+    const auto start = std::chrono::steady_clock::now();
+    while (!board.isGameOver() && board.move(policy(board))) ++result.moves;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.score = board.getScore();
+    for (int i = 0; i < 16; ++i) {
+        const int tile = static_cast<int>((board.getState().board >> (i * 4)) & 0xF);
+        if (tile > result.maxTile) result.maxTile = tile;
+    }
+    return result;
+}
+
+template <typename Policy>
+static void run(const char* name, const int games, Policy&& policy) {
+    double seconds = 0, score = 0;
+    long long moves = 0;
+    int reached2048 = 0;
+    for (int g = 0; g < games; ++g) {
+        const GameResult r = playGame(static_cast<uint64_t>(g + 1), policy);
+        seconds += r.seconds;
+        score += r.score;
+        moves += r.moves;
+        reached2048 += r.maxTile >= 11;
+        std::printf("  %-8s game %2d  score %7d  max %5d  moves %5lld  %7.2f s\n", name, g + 1, r.score, 1 << r.maxTile, r.moves, r.seconds);
+        std::fflush(stdout);
+    }
+    std::printf("%-8s  mean score %9.0f   2048 rate %3d/%d   %7.2f s/game   %6.2f ms/move\n", name, score / games, reached2048, games, seconds / games,
+                1e3 * seconds / static_cast<double>(moves));
+}
+
+int main(int argc, char** argv) {
+    const int games = argc > 1 ? std::stoi(argv[1]) : 5;
+    const int budgetMs = argc > 2 ? std::stoi(argv[2]) : 10;
+
+    SearchOptions options;
+    options.timeLimitMs = budgetMs;
+    run("fixed", games, [&](const Board& b) { return AISolver::findBestMove(b, 12, options); });
+    run("adaptive", games, [&](const Board& b) { return AISolver::findBestMove(b, AISolver::planSearch(b, budgetMs), options); });
+    return 0;
+}
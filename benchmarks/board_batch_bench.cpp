@@ -0,0 +1,48 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/board.h"
+#include "core/board_batch.h"
+
+using namespace tfe::core;
+
+// Compares aggregate moves/sec of BoardBatch::step against a loop over Board::move.
+int main(int argc, char** argv) {
+    const std::size_t games = argc > 1 ? std::stoul(argv[1]) : 4096;
+    const int steps = argc > 2 ? std::stoi(argv[2]) : 2000;
+
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::vector<Direction> dirs(games * steps);
+    for (auto& d : dirs) d = static_cast<Direction>(pick(rng));
+
+    // 1. Loop over Board::move
+    std::vector<Board> boards(games);
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        const Direction* stepDirs = dirs.data() + s * games;
+        for (std::size_t i = 0; i < games; ++i) {
+            boards[i].move(stepDirs[i]);
+            if (boards[i].isGameOver()) boards[i].reset();
+        }
+    }
+    const double loopSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // 2. BoardBatch
+    BoardBatch batch(games);
+    start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        batch.step({dirs.data() + s * games, games});
+        batch.resetFinished();
+    }
+    const double batchSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double totalMoves = static_cast<double>(games) * steps;
+    std::printf("games=%zu steps=%d kernel=%s\n", games, steps, BoardBatch::simdEnabled() ? "avx2" : "scalar");
+    std::printf("Board::move loop : %8.2f M moves/s\n", totalMoves / loopSec / 1e6);
+    std::printf("BoardBatch::step : %8.2f M moves/s (x%.2f)\n", totalMoves / batchSec / 1e6, loopSec / batchSec);
+    return 0;
+}
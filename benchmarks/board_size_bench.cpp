@@ -0,0 +1,52 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "core/ai_solver.h"
+#include "core/sized_board.h"
+
+using namespace tfe::core;
+
+// Per-size throughput: random-play moves/sec (move + spawn + game-over check) and solver decision time.
+template <int N>
+static void benchSize(const int moves, const int decisions, const int depth) {
+    SizedBoard<N> board(N);
+    tfe::utils::RandomGenerator pick(1);
+
+    // Warm-up builds the 3x3/5x5 line tables outside the timed loop
+    board.move(Direction::Left);
+
+    auto start = std::chrono::steady_clock::now();
+    long long games = 0;
+    for (int i = 0; i < moves; ++i) {
+        board.move(static_cast<Direction>(pick.getInt(0, 3)));
+        if (board.isGameOver()) {
+            board.reset();
+            ++games;
+        }
+    }
+    const double playSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    board.reset();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < decisions; ++i) {
+        board.move(AISolver::findBestMove(board, depth));
+        if (board.isGameOver()) board.reset();
+    }
+    const double solveSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%dx%d   words=%d   %8.2f M moves/s   %9.3f ms/decision (depth %d)   games=%lld\n", N, N, SizedLayout<N>::WORDS,
+                moves / playSec / 1e6, solveSec * 1e3 / decisions, depth, games);
+}
+
+int main(int argc, char** argv) {
+    const int moves = argc > 1 ? std::stoi(argv[1]) : 2000000;
+    const int decisions = argc > 2 ? std::stoi(argv[2]) : 50;
+    const int depth = argc > 3 ? std::stoi(argv[3]) : 2;
+
+    benchSize<3>(moves, decisions, depth);
+    benchSize<4>(moves, decisions, depth);
+    benchSize<5>(moves, decisions, depth);
+    benchSize<6>(moves, decisions, depth);
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/bitboard.h"
+#include "core/config.h"
+#include "core/lookup_table.h"
+
+using namespace tfe::core;
+
+// Per-direction cost of a full-board move: the old transpose + row-table path against the column tables.
+
+static Bitboard moveRowsTable(const Bitboard board, const Row* table) {
+    Bitboard result = 0;
+    for (int r = 0; r < 4; ++r) result |= static_cast<Bitboard>(table[(board >> (r * 16)) & Config::ROW_MASK]) << (r * 16);
+    return result;
+}
+
+// Before: Up/Down transpose, move as rows, transpose back
+static Bitboard moveTransposed(const Bitboard board, const Row* table) { return transpose64(moveRowsTable(transpose64(board), table)); }
+
+// After: four column lookups ORed together
+static Bitboard moveColumns(const Bitboard board, const Bitboard* table) {
+    return table[extractColumn(board, 0)] | (table[extractColumn(board, 1)] << 4) | (table[extractColumn(board, 2)] << 8) | (table[extractColumn(board, 3)] << 12);
+}
+
+template <typename Fn>
+static double nsPerMove(const std::vector<Bitboard>& boards, const int rounds, Fn&& fn) {
+    Bitboard sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < rounds; ++k)
+        for (const Bitboard b : boards) sink ^= fn(b ^ sink);  // Chain results so the loop can't be hoisted
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (sink == 0x1234) std::printf(" ");
+    return ns / (static_cast<double>(boards.size()) * rounds);
+}
+
+int main(int argc, char** argv) {
+    const int rounds = argc > 1 ? std::stoi(argv[1]) : 50;
+    std::mt19937_64 rng(7);
+    std::vector<Bitboard> boards(1 << 16);
+    for (auto& b : boards) {
+        b = 0;
+        for (int i = 0; i < 16; ++i)
+            if (rng() % 3) b |= static_cast<Bitboard>(rng() % 11 + 1) << (i * 4);
+    }
+
+    const double up0 = nsPerMove(boards, rounds, [](const Bitboard b) { return moveTransposed(b, LookupTable::moveLeftTable); });
+    const double up1 = nsPerMove(boards, rounds, [](const Bitboard b) { return moveColumns(b, LookupTable::moveUpCol); });
+    const double down0 = nsPerMove(boards, rounds, [](const Bitboard b) { return moveTransposed(b, LookupTable::moveRightTable); });
+    const double down1 = nsPerMove(boards, rounds, [](const Bitboard b) { return moveColumns(b, LookupTable::moveDownCol); });
+    const double left = nsPerMove(boards, rounds, [](const Bitboard b) { return moveRowsTable(b, LookupTable::moveLeftTable); });
+    const double right = nsPerMove(boards, rounds, [](const Bitboard b) { return moveRowsTable(b, LookupTable::moveRightTable); });
+
+    std::printf("direction   transpose+rows   column tables   (ns/move)\n");
+    std::printf("Up          %14.2f   %13.2f\n", up0, up1);
+    std::printf("Down        %14.2f   %13.2f\n", down0, down1);
+    std::printf("Left        %14.2f   %13s\n", left, "-");
+    std::printf("Right       %14.2f   %13s\n", right, "-");
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+
+using namespace tfe::core;
+
+// Per-move latency against a hard deadline: the search is asked for a depth it can never finish,
+// so every move ends by aborting mid-iteration. Reports how far past the budget moves return.
+static void benchBudget(const std::vector<Board>& positions, const int budgetMs, const int threads) {
+    SearchOptions options;
+    options.threads = threads;
+    std::vector<double> ms;
+    for (const Board& board : positions) {
+        const auto start = std::chrono::steady_clock::now();
+        AISolver::findBestMove(board, SearchLimits::withTimeBudget(budgetMs, 30), options);
+        ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(ms.begin(), ms.end());
+    const auto pct = [&](const double p) { return ms[static_cast<std::size_t>(p * static_cast<double>(ms.size() - 1))]; };
+    std::printf("budget %4d ms  threads %d   p50 %7.2f   p99 %7.2f   max %7.2f  (ms/move)   worst overshoot %6.2f ms\n", budgetMs, threads, pct(0.5),
+                pct(0.99), ms.back(), ms.back() - budgetMs);
+}
+
+int main(int argc, char** argv) {
+    const int moves = argc > 1 ? std::stoi(argv[1]) : 100;
+    const int threads = argc > 2 ? std::stoi(argv[2]) : 1;
+
+    SearchOptions quick;
+    quick.timeLimitMs = 0;
+    std::vector<Board> positions;
+    Board board(4, 1);
+    while (static_cast<int>(positions.size()) < moves && !board.isGameOver()) {
+        positions.push_back(board);
+        board.move(AISolver::findBestMove(board, 2, quick));
+    }
+
+    for (const int budget : {5, 20, 100}) benchBudget(positions, budget, threads);
+    return 0;
+}
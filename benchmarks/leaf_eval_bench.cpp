@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+#include "core/leaf_eval.h"
+#include "core/transposition_table.h"
+
+using namespace tfe::core;
+
+// Leaf evaluations per second: one evaluateLeaf call per board (the old per-leaf path) against
+// evaluateLeaves over chance-node sized batches, on boards taken from a real game. Then the
+// end-to-end effect on a depth-4 search.
+int main(int argc, char** argv) {
+    const int rounds = argc > 1 ? std::stoi(argv[1]) : 20;
+    const int batch = argc > 2 ? std::stoi(argv[2]) : 24;
+
+    // Leaves of a real game: both spawns on every empty cell of each position
+    SearchOptions quick;
+    quick.timeLimitMs = 0;
+    std::vector<Board> positions;
+    std::vector<Bitboard> leaves;
+    for (uint64_t seed = 1; leaves.size() < 200000; ++seed) {
+        Board board(4, seed);
+        while (!board.isGameOver() && leaves.size() < 200000) {
+            positions.push_back(board);
+            const Bitboard state = board.getState().board;
+            for (uint64_t cells = emptyMask(state); cells != 0; cells &= cells - 1) {
+                leaves.push_back(state | (Bitboard{1} << std::countr_zero(cells)));
+                leaves.push_back(state | (Bitboard{2} << std::countr_zero(cells)));
+            }
+            board.move(AISolver::findBestMove(board, 2, quick));
+        }
+    }
+    std::vector<float> scores(leaves.size());
+    const auto count = leaves.size();
+
+    float sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (std::size_t i = 0; i < count; ++i) scores[i] = evaluateLeaf(leaves[i]);
+        sink += scores[r % count];
+    }
+    const double scalarSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (std::size_t i = 0; i < count; i += static_cast<std::size_t>(batch)) {
+            evaluateLeaves(leaves.data() + i, scores.data() + i, std::min<std::size_t>(static_cast<std::size_t>(batch), count - i));
+        }
+        sink += scores[r % count];
+    }
+    const double batchSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double evals = static_cast<double>(count) * rounds;
+    std::printf("leaves=%zu batch=%d simd=%s\n", count, batch, leafEvalSimdEnabled() ? "avx2" : "scalar+prefetch");
+    std::printf("per leaf   %8.1f M leaves/s\n", evals / scalarSec / 1e6);
+    std::printf("batched    %8.1f M leaves/s   (%.2fx)\n", evals / batchSec / 1e6, scalarSec / batchSec);
+
+    // End to end: the search batches the leaf layer of every chance node
+    SearchOptions options;
+    options.timeLimitMs = 0;
+    options.reuseTable = false;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < positions.size() && i < 150; ++i) AISolver::findBestMove(positions[i], 4, options);
+    std::printf("search     %8.2f ms/move (depth 4)   [%g]\n",
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / std::min<double>(150, positions.size()), sink);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+#include "core/mcts_solver.h"
+#include "utils/thread-pool.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    int maxTile(const Board& board) {
+        int tile = 0;
+        for (int i = 0; i < 16; ++i) tile = std::max(tile, static_cast<int>((board.getState().board >> (4 * i)) & 0xF));
+        return 1 << tile;
+    }
+
+}  // namespace
+
+// MCTSSolver: playouts per second as threads are added (root parallelization), then whole games
+// against expectimax (AISolver::planSearch) with the same time budget per move.
+int main(int argc, char** argv) {
+    const int budgetMs = argc > 1 ? std::stoi(argv[1]) : 20;
+    const int games = argc > 2 ? std::stoi(argv[2]) : 3;
+
+    // Positions from one game, every 50th move
+    std::vector<Board> positions;
+    Board game(4, 1);
+    for (int move = 0; !game.isGameOver(); ++move) {
+        if (move % 50 == 0) positions.push_back(game);
+        game.move(AISolver::findBestMove(game, 2));
+    }
+
+    std::printf("positions=%zu budget=%d ms hardware threads=%d\n", positions.size(), budgetMs, tfe::utils::ThreadPool::hardwareThreads());
+    for (int threads = 1; threads <= std::max(4, tfe::utils::ThreadPool::hardwareThreads()); threads *= 2) {
+        MCTSOptions options;
+        options.threads = threads;
+        options.timeLimitMs = budgetMs;
+        options.seed = 7;
+        uint64_t playouts = 0;
+        double ms = 0;
+        for (const Board& position : positions) {
+            MCTSStats stats;
+            MCTSSolver::findBestMove(position, options, &stats);
+            playouts += stats.playouts;
+            ms += stats.totalMs;
+        }
+        std::printf("threads %2d: %9.0f playouts/s\n", threads, static_cast<double>(playouts) / (ms / 1000));
+        std::fflush(stdout);
+    }
+
+    for (const bool mcts : {true, false}) {
+        long long total = 0;
+        int best = 0;
+        long moves = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int g = 0; g < games; ++g) {
+            Board board(4, static_cast<uint64_t>(g + 1));
+            MCTSOptions options;
+            options.timeLimitMs = budgetMs;
+            options.seed = static_cast<uint64_t>(g + 1);
+            SearchOptions searchOptions;
+            while (!board.isGameOver()) {
+                board.move(mcts ? MCTSSolver::findBestMove(board, options)
+                                : AISolver::findBestMove(board, AISolver::planSearch(board, budgetMs), searchOptions));
+                ++moves;
+            }
+            total += board.getScore();
+            best = std::max(best, maxTile(board));
+        }
+        const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-10s: mean score %.0f, best tile %d, %.2f ms/move\n", mcts ? "mcts" : "expectimax", static_cast<double>(total) / games, best,
+                    1000 * sec / static_cast<double>(moves));
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+#include "core/leaf_eval.h"
+#include "core/move_kernel.h"
+#include "core/ntuple_network.h"
+
+using namespace tfe::core;
+
+// Trains the standard 4 x 6-tuple network by TD(0) on afterstates (greedy self-play), then plays
+// the same seeded games at equal search depth with the heuristic table and with the network.
+// Optional 4th argument: file the trained network is saved to; with 0 training games it is loaded from there instead.
+int main(int argc, char** argv) {
+    const int trainGames = argc > 1 ? std::stoi(argv[1]) : 5000;
+    const int evalGames = argc > 2 ? std::stoi(argv[2]) : 10;
+    const int depth = argc > 3 ? std::stoi(argv[3]) : 2;
+
+    NTupleNetwork network(NTupleNetwork::standardTuples(), true);
+    if (trainGames == 0 && argc > 4 && !NTupleNetwork::load(argv[4], network)) return 1;
+    const float alpha = 0.1f / static_cast<float>(network.tupleCount() * 8);  // Per-weight step of a symmetric read
+
+    auto start = std::chrono::steady_clock::now();
+    long long trainScore = 0;
+    for (int game = 0; game < trainGames; ++game) {
+        Board board(4, static_cast<uint64_t>(1000000 + game));
+        Bitboard previous = 0;  // Afterstate of the previous move
+        bool hasPrevious = false;
+        while (!board.isGameOver()) {
+            const MoveSet moves = computeMoves(board.getState().board);
+            int best = -1;
+            float bestValue = 0;
+            for (int dir = 0; dir < 4; ++dir) {
+                if (!((moves.legal >> dir) & 1)) continue;
+                const float value = static_cast<float>(moves.reward[dir]) + network.evaluate(moves.after[dir]);
+                if (best < 0 || value > bestValue) {
+                    best = dir;
+                    bestValue = value;
+                }
+            }
+            if (hasPrevious) network.update(previous, alpha * (bestValue - network.evaluate(previous)));
+            previous = moves.after[best];
+            hasPrevious = true;
+            board.move(static_cast<Direction>(best));
+        }
+        if (hasPrevious) network.update(previous, -alpha * network.evaluate(previous));  // Terminal: no future reward
+        trainScore += board.getScore();
+        if ((game + 1) % 1000 == 0) {
+            std::printf("train %5d games: mean greedy score (last 1000) %.0f\n", game + 1, static_cast<double>(trainScore) / 1000);
+            std::fflush(stdout);
+            trainScore = 0;
+        }
+    }
+    const double trainSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("trained %d games in %.1f s, %.0f MB of weights\n", trainGames, trainSec, static_cast<double>(network.sizeBytes()) / (1 << 20));
+    if (trainGames > 0 && argc > 4 && !network.save(argv[4])) std::printf("could not save %s\n", argv[4]);
+
+    // Evaluation cost per leaf
+    std::vector<Bitboard> leaves;
+    Board sample(4, 7);
+    while (!sample.isGameOver() && leaves.size() < 100000) {
+        leaves.push_back(sample.getState().board);
+        sample.move(AISolver::findBestMove(sample, 1));
+    }
+    float sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < 20; ++r) for (const Bitboard leaf : leaves) sink += evaluateLeaf(leaf);
+    const double tableNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (20.0 * leaves.size());
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < 20; ++r) for (const Bitboard leaf : leaves) sink += network.evaluate(leaf);
+    const double networkNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (20.0 * leaves.size());
+    std::printf("eval: table %.1f ns, network %.1f ns (sink %g)\n", tableNs, networkNs, static_cast<double>(sink));
+
+    for (const NTupleNetwork* evaluator : {static_cast<const NTupleNetwork*>(nullptr), static_cast<const NTupleNetwork*>(&network)}) {
+        SearchOptions options;
+        options.timeLimitMs = 0;
+        options.evaluator = evaluator;
+        long long total = 0;
+        int reached2048 = 0, maxTile = 0;
+        start = std::chrono::steady_clock::now();
+        for (int game = 0; game < evalGames; ++game) {
+            Board board(4, static_cast<uint64_t>(game + 1));
+            while (!board.isGameOver()) board.move(AISolver::findBestMove(board, depth, options));
+            total += board.getScore();
+            int tile = 0;
+            for (int i = 0; i < 16; ++i) tile = std::max(tile, static_cast<int>((board.getState().board >> (4 * i)) & 0xF));
+            reached2048 += tile >= 11;
+            maxTile = std::max(maxTile, tile);
+        }
+        const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-9s depth %d: mean score %.0f, 2048 in %d/%d, best tile %d, %.2f s/game\n", evaluator ? "network" : "heuristic", depth,
+                    static_cast<double>(total) / evalGames, reached2048, evalGames, 1 << maxTile, sec / evalGames);
+        std::fflush(stdout);
+    }
+    return 0;
+}
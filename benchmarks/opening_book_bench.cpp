@@ -0,0 +1,112 @@
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/bitboard.h"
+#include "core/board.h"
+#include "core/opening_book.h"
+#include "utils/random-generator.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double msSince(const Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); }
+
+    // Opening-like board: 2-8 small tiles (2..32) on random cells
+    Bitboard randomOpening(tfe::utils::RandomGenerator& rng) {
+        Bitboard board = 0;
+        for (int tiles = rng.getInt(2, 8); tiles > 0; --tiles) {
+            const int cell = rng.getInt(0, 15);
+            board = (board & ~(Bitboard{0xF} << (4 * cell))) | (static_cast<Bitboard>(rng.getInt(1, 5)) << (4 * cell));
+        }
+        return board;
+    }
+
+}  // namespace
+
+// OpeningBook: build (canonicalize + sort + write) and open throughput on a synthetic book, probe cost on hits
+// in random orientations and on misses, then a real book of game positions against the search it replaces.
+int main(int argc, char** argv) {
+    const std::size_t size = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    const std::string path = argc > 2 ? argv[2] : "opening_book_bench.bin";
+
+    tfe::utils::RandomGenerator rng(1);
+    std::vector<OpeningBook::Entry> entries;
+    std::unordered_set<Bitboard> classes;
+    while (entries.size() < size) {
+        const Bitboard board = randomOpening(rng);
+        const uint8_t legal = legalMoves(board);
+        if (legal == 0 || !classes.insert(canonicalBoard(board)).second) continue;
+        entries.push_back({board, static_cast<Direction>(std::countr_zero(legal))});
+    }
+
+    auto start = Clock::now();
+    const std::size_t written = OpeningBook::write(path.c_str(), entries);
+    const double buildMs = msSince(start);
+    std::printf("build  %zu positions in %.1f ms (%.2f M positions/s, %.1f MB)\n", written, buildMs, written / buildMs / 1000,
+                (16.0 + 9.0 * static_cast<double>(written)) / (1 << 20));
+
+    OpeningBook book;
+    start = Clock::now();
+    if (!book.open(path.c_str())) return 1;
+    std::printf("open   %.3f ms\n", msSince(start));
+
+    // Hits: every entry, in a random orientation
+    std::vector<Bitboard> hits, misses;
+    for (const OpeningBook::Entry& entry : entries) {
+        Bitboard orientations[8];
+        symmetries(entry.board, orientations);
+        hits.push_back(orientations[rng.getInt(0, 7)]);
+    }
+    while (misses.size() < hits.size()) {
+        const Bitboard board = randomOpening(rng) | (Bitboard{9} << (4 * rng.getInt(0, 15)));  // A 512 is never in the book
+        misses.push_back(board);
+    }
+    for (const auto& [name, boards] : {std::pair{"hit ", &hits}, std::pair{"miss", &misses}}) {
+        std::size_t found = 0;
+        start = Clock::now();
+        for (const Bitboard board : *boards) found += book.probe(board).has_value();
+        const double ms = msSince(start);
+        std::printf("probe  %s %6.1f ns/probe (%zu/%zu found)\n", name, ms * 1e6 / static_cast<double>(boards->size()), found, boards->size());
+    }
+    book.close();
+    std::remove(path.c_str());
+
+    // Real positions: the first 30 moves of 100 games, searched at depth 4 into a book
+    std::vector<Board> positions;
+    entries.clear();
+    for (uint64_t seed = 1; seed <= 100; ++seed) {
+        Board game(4, seed);
+        for (int move = 0; move < 30 && !game.isGameOver(); ++move) {
+            positions.push_back(game);
+            game.move(AISolver::findBestMove(game, 2));
+        }
+    }
+    SearchLimits limits;
+    limits.maxDepth = 4;
+    start = Clock::now();
+    for (const Board& position : positions) entries.push_back({position.getState().board, AISolver::findBestMove(position, limits)});
+    const double searchMs = msSince(start);
+    OpeningBook::write(path.c_str(), entries);
+    book.open(path.c_str());
+
+    SearchOptions options;
+    options.book = &book;
+    std::size_t agree = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < positions.size(); ++i) agree += AISolver::findBestMove(positions[i], limits, options) == entries[i].move;
+    const double bookMs = msSince(start);
+    std::printf("solve  %zu opening positions: search %.3f ms/move, book %.2f us/move (%.0fx), %zu/%zu same move\n", positions.size(),
+                searchMs / static_cast<double>(positions.size()), bookMs * 1000 / static_cast<double>(positions.size()), searchMs / bookMs, agree,
+                positions.size());
+    book.close();
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+#include "utils/thread-pool.h"
+
+using namespace tfe::core;
+
+// Speedup curve of the parallel expectimax: the same positions searched to a fixed depth
+// (no time budget) with 1, 2, 4, ... threads, up to the requested maximum.
+int main(int argc, char** argv) {
+    const int maxThreads = argc > 1 ? std::stoi(argv[1]) : 32;
+    const int depth = argc > 2 ? std::stoi(argv[2]) : 4;
+    const int positions = argc > 3 ? std::stoi(argv[3]) : 20;
+
+    // Mid-game positions from a seeded depth-2 game
+    std::vector<Board> boards;
+    Board board(4, 42);
+    SearchOptions quick;
+    quick.timeLimitMs = 0;
+    for (int i = 0; boards.size() < static_cast<std::size_t>(positions) && !board.isGameOver(); ++i) {
+        board.move(AISolver::findBestMove(board, 2, quick));
+        if (i >= 100 && i % 10 == 0) boards.push_back(board);
+    }
+
+    std::vector<int> counts;
+    for (int t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    std::printf("depth=%d positions=%zu hardware threads=%d\n", depth, boards.size(), tfe::utils::ThreadPool::hardwareThreads());
+    std::printf("threads   ms/move   speedup   efficiency\n");
+    double baseline = 0;
+    for (const int threads : counts) {
+        SearchOptions options;
+        options.threads = threads;
+        options.timeLimitMs = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const Board& b : boards) AISolver::findBestMove(b, depth, options);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / boards.size();
+        if (threads == 1) baseline = ms;
+        std::printf("%7d   %7.2f   %7.2fx   %9.0f%%\n", threads, ms, baseline / ms, 100.0 * baseline / ms / threads);
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+// Minimal hardware cache counters for the benchmarks (Linux perf_event_open).
+// Counters read as -1 when unavailable (other platforms, containers without perf access).
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+class CacheCounters {
+public:
+    CacheCounters() {
+#if defined(__linux__)
+        l1Fd_ = open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        // The generic events have no L2 level; LL (last level) misses are what leave the core's caches
+        llFd_ = open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#endif
+    }
+
+    ~CacheCounters() {
+#if defined(__linux__)
+        if (l1Fd_ >= 0) close(l1Fd_);
+        if (llFd_ >= 0) close(llFd_);
+#endif
+    }
+
+    bool available() const { return l1Fd_ >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        for (const int fd : {l1Fd_, llFd_}) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Stops counting and returns {L1D read misses, LL read misses}
+    void stop(int64_t& l1Misses, int64_t& llMisses) {
+        l1Misses = read(l1Fd_);
+        llMisses = read(llFd_);
+    }
+
+private:
+    int l1Fd_ = -1;
+    int llFd_ = -1;
+
+#if defined(__linux__)
+    static int open(const uint32_t type, const uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static int64_t read(const int fd) {
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        int64_t value = 0;
+        if (::read(fd, &value, sizeof(value)) != sizeof(value)) return -1;
+        return value;
+    }
+#else
+    static int64_t read(int) { return -1; }
+#endif
+};
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+#include "core/leaf_eval.h"
+#include "core/lookup_table.h"
+
+using namespace tfe::core;
+
+// Float32 against Int16 and Float16 heuristic tables: leaf evaluations per second (per leaf and
+// batched), search nodes per second at a fixed depth, and how often the chosen move matches the
+// float table on the same positions.
+int main(int argc, char** argv) {
+    const int depth = argc > 1 ? std::stoi(argv[1]) : 4;
+    const int rounds = argc > 2 ? std::stoi(argv[2]) : 20;
+
+    // Positions and their leaves from real games
+    SearchOptions quick;
+    quick.timeLimitMs = 0;
+    std::vector<Board> positions;
+    std::vector<Bitboard> leaves;
+    for (uint64_t seed = 1; leaves.size() < 200000; ++seed) {
+        Board board(4, seed);
+        while (!board.isGameOver() && leaves.size() < 200000) {
+            positions.push_back(board);
+            const Bitboard state = board.getState().board;
+            for (uint64_t cells = emptyMask(state); cells != 0; cells &= cells - 1) {
+                leaves.push_back(state | (Bitboard{1} << std::countr_zero(cells)));
+                leaves.push_back(state | (Bitboard{2} << std::countr_zero(cells)));
+            }
+            board.move(AISolver::findBestMove(board, 2, quick));
+        }
+    }
+    // Every 25th position: a spread over the game phases
+    std::vector<Board> sample;
+    for (std::size_t i = 0; i < positions.size(); i += 25) sample.push_back(positions[i]);
+
+    SearchOptions options;
+    options.timeLimitMs = 0;
+    options.reuseTable = false;
+    std::vector<Direction> reference;
+    std::printf("leaves=%zu positions=%zu depth=%d simd=%s\n", leaves.size(), sample.size(), depth, leafEvalSimdEnabled() ? "avx2" : "scalar");
+    std::printf("%-8s %10s %10s %12s %8s\n", "table", "leaf Mev/s", "batch Mev/s", "search Mn/s", "agree");
+
+    for (const WeightPrecision precision : {WeightPrecision::Float32, WeightPrecision::Int16, WeightPrecision::Float16}) {
+        LookupTable::setWeightPrecision(precision);
+        std::vector<float> scores(leaves.size());
+        float sink = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < leaves.size(); ++i) scores[i] = evaluateLeaf(leaves[i]);
+            sink += scores[static_cast<std::size_t>(r)];
+        }
+        const double leafSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (std::size_t i = 0; i < leaves.size(); i += 24) evaluateLeaves(leaves.data() + i, scores.data() + i, std::min<std::size_t>(24, leaves.size() - i));
+            sink += scores[static_cast<std::size_t>(r)];
+        }
+        const double batchSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        uint64_t nodes = 0;
+        int agree = 0;
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < sample.size(); ++i) {
+            SearchStats stats;
+            const Direction dir = AISolver::findBestMove(sample[i], SearchLimits::withTimeBudget(0, depth), options, &stats);
+            nodes += stats.nodes;
+            if (precision == WeightPrecision::Float32) reference.push_back(dir);
+            agree += dir == reference[i];
+        }
+        const double searchSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const double evals = static_cast<double>(leaves.size()) * rounds;
+        const char* name = precision == WeightPrecision::Float32 ? "float32" : precision == WeightPrecision::Int16 ? "int16" : "float16";
+        std::printf("%-8s %10.1f %10.1f %12.2f %5d/%zu (sink %g)\n", name, evals / leafSec / 1e6, evals / batchSec / 1e6,
+                    static_cast<double>(nodes) / searchSec / 1e6, agree, sample.size(), static_cast<double>(sink));
+        std::fflush(stdout);
+    }
+    return 0;
+}
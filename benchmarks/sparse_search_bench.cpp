@@ -0,0 +1,55 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+
+using namespace tfe::core;
+
+// Depth/score trade-off of sparse chance nodes at a fixed time budget per move: the same seeded games
+// played with full chance nodes and with sampled ones. Sampling buys depth; the question is whether
+// the deeper, noisier estimate plays better than the shallower exact one.
+static void playGames(const char* name, const int games, const int budgetMs, const SearchOptions& options) {
+    double seconds = 0, score = 0, depthSum = 0;
+    long long moves = 0;
+    for (int g = 0; g < games; ++g) {
+        Board board(4, static_cast<uint64_t>(g + 1));
+        const auto start = std::chrono::steady_clock::now();
+        while (!board.isGameOver()) {
+            SearchStats stats;
+            const Direction dir = AISolver::findBestMove(board, SearchLimits::withTimeBudget(budgetMs, 12), options, &stats);
+            depthSum += stats.depthReached;
+            ++moves;
+            if (!board.move(dir)) break;
+        }
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        score += board.getScore();
+    }
+    std::printf("%-22s  mean depth %5.2f   mean score %9.0f   %7.2f s/game   %6.2f ms/move\n", name, depthSum / static_cast<double>(moves), score / games,
+                seconds / games, 1e3 * seconds / static_cast<double>(moves));
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    const int games = argc > 1 ? std::stoi(argv[1]) : 4;
+    const int budgetMs = argc > 2 ? std::stoi(argv[2]) : 5;
+
+    std::printf("games=%d budget=%d ms/move\n", games, budgetMs);
+    SearchOptions exact;
+    playGames("exact", games, budgetMs, exact);
+
+    SearchOptions sampled = exact;
+    sampled.sampleSpawns = 4;
+    sampled.sampleFromPly = 1;
+    playGames("k=4 from ply 1", games, budgetMs, sampled);
+
+    sampled.sampleSpawns = 2;
+    sampled.sampleFromPly = 1;
+    playGames("k=2 from ply 1", games, budgetMs, sampled);
+
+    SearchOptions noFours = exact;
+    noFours.skipFoursBelowProb = 0.01f;
+    playGames("skip 4s below p=0.01", games, budgetMs, noFours);
+    return 0;
+}
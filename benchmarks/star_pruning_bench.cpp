@@ -0,0 +1,64 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+
+using namespace tfe::core;
+
+// Star1 pruning (SearchOptions::starPruning) against the plain search on the same positions: every
+// stride-th position of seeded games, searched to maxDepth with a fresh table. Reports the nodes and
+// time of each iterative-deepening depth with and without pruning, and how many decisions agree.
+// Cutoffs are only counted in TFE_SEARCH_STATS builds. Usage: star_pruning_bench [maxDepth] [games] [stride]
+int main(int argc, char** argv) {
+    const int maxDepth = argc > 1 ? std::stoi(argv[1]) : 4;
+    const int games = argc > 2 ? std::stoi(argv[2]) : 2;
+    const int stride = argc > 3 ? std::stoi(argv[3]) : 20;
+
+    std::vector<Board> positions;
+    for (int g = 0; g < games; ++g) {
+        Board board(4, static_cast<uint64_t>(g + 1));
+        for (int move = 0; !board.isGameOver(); ++move) {
+            if (move % stride == 0) positions.push_back(board);
+            board.move(AISolver::findBestMove(board, 2));
+        }
+    }
+
+    SearchOptions plain;
+    plain.timeLimitMs = 0;
+    plain.reuseTable = false;
+    SearchOptions star = plain;
+    star.starPruning = true;
+    SearchLimits limits;
+    limits.maxDepth = maxDepth;
+
+    std::vector<uint64_t> plainNodes(maxDepth), starNodes(maxDepth);
+    std::vector<double> plainMs(maxDepth), starMs(maxDepth);
+    uint64_t cutoffs = 0;
+    std::size_t agree = 0;
+    for (const Board& position : positions) {
+        SearchStats a, b;
+        const Direction expected = AISolver::findBestMove(position, limits, plain, &a);
+        agree += AISolver::findBestMove(position, limits, star, &b) == expected;
+        cutoffs += b.starCutoffs;
+        for (std::size_t d = 0; d < a.iterations.size() && d < b.iterations.size(); ++d) {
+            plainNodes[d] += a.iterations[d].nodes;
+            starNodes[d] += b.iterations[d].nodes;
+            plainMs[d] += a.iterations[d].ms;
+            starMs[d] += b.iterations[d].ms;
+        }
+    }
+
+    std::printf("%zu positions (%d games, every %d moves), %zu/%zu same decision, %llu star cutoffs\n", positions.size(), games, stride, agree,
+                positions.size(), static_cast<unsigned long long>(cutoffs));
+    std::printf("depth  %14s %14s %8s   %10s %10s\n", "plain nodes", "star nodes", "saved", "plain ms", "star ms");
+    for (int d = 0; d < maxDepth; ++d) {
+        const double saved = plainNodes[d] == 0 ? 0.0 : 100.0 * (1.0 - static_cast<double>(starNodes[d]) / static_cast<double>(plainNodes[d]));
+        std::printf("%5d  %14llu %14llu %7.1f%%   %10.1f %10.1f\n", d + 1, static_cast<unsigned long long>(plainNodes[d]),
+                    static_cast<unsigned long long>(starNodes[d]), saved, plainMs[d], starMs[d]);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/bitboard.h"
+#include "core/lookup_table.h"
+#include "core/move_kernel.h"
+#include "perf_counters.h"
+
+using namespace tfe::core;
+
+// Split vs packed lookup table layout inside a plain expectimax (no transposition table, so every
+// node touches the move tables). Reports time and L1D / last-level cache read misses per node.
+
+static uint64_t nodes = 0;
+
+static float evaluate(const Bitboard board) {
+    const Bitboard t = transpose64(board);
+    float score = 0;
+    for (int i = 0; i < 4; ++i) score += LookupTable::heuristicTable[(board >> (i * 16)) & 0xFFFF] + LookupTable::heuristicTable[(t >> (i * 16)) & 0xFFFF];
+    return score;
+}
+
+template <MoveSet (*Kernel)(Bitboard)>
+static float search(const Bitboard board, const int depth, const bool maxNode) {
+    nodes++;
+    if (depth == 0) return evaluate(board);
+    if (maxNode) {
+        const MoveSet moves = Kernel(board);
+        float best = 0;
+        for (int d = 0; d < 4; ++d)
+            if ((moves.legal >> d) & 1) best = std::max(best, search<Kernel>(moves.after[d], depth, false));
+        return best;
+    }
+    float total = 0;
+    int empty = 0;
+    for (int i = 0; i < 16; ++i) {
+        if ((board >> (i * 4)) & 0xF) continue;
+        empty++;
+        total += 0.9f * search<Kernel>(board | (Bitboard{1} << (i * 4)), depth - 1, true);
+        total += 0.1f * search<Kernel>(board | (Bitboard{2} << (i * 4)), depth - 1, true);
+    }
+    return empty ? total / static_cast<float>(empty) : evaluate(board);
+}
+
+template <MoveSet (*Kernel)(Bitboard)>
+static void run(const char* name, const std::vector<Bitboard>& positions, const int depth) {
+    CacheCounters counters;
+    nodes = 0;
+    float sink = 0;
+    counters.start();
+    const auto start = std::chrono::steady_clock::now();
+    for (const Bitboard b : positions) sink += search<Kernel>(b, depth, true);
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    int64_t l1 = 0, ll = 0;
+    counters.stop(l1, ll);
+
+    const double perNode = 1.0 / static_cast<double>(nodes);
+    std::printf("%-7s nodes=%-11llu %7.1f ns/node", name, static_cast<unsigned long long>(nodes), sec * 1e9 * perNode);
+    if (counters.available())
+        std::printf("   L1D miss/node=%.4f   LL miss/node=%.5f\n", l1 * perNode, ll * perNode);
+    else
+        std::printf("   (perf counters unavailable)\n");
+    if (sink == 1.0f) std::printf(" ");
+}
+
+int main(int argc, char** argv) {
+    const int depth = argc > 1 ? std::stoi(argv[1]) : 2;
+    const int count = argc > 2 ? std::stoi(argv[2]) : 200;
+
+    // Mid-game style positions with large tiles, which spread accesses across the tables
+    std::mt19937_64 rng(2048);
+    std::vector<Bitboard> positions(count);
+    for (auto& b : positions) {
+        b = 0;
+        for (int i = 0; i < 16; ++i)
+            if (rng() % 8 < 5) b |= static_cast<Bitboard>(rng() % 12 + 1) << (i * 4);
+    }
+
+    std::printf("depth=%d positions=%d\n", depth, count);
+    run<computeMovesSplit>("split", positions, depth);
+    run<computeMovesPacked>("packed", positions, depth);
+    return 0;
+}
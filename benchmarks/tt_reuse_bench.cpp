@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/board.h"
+#include "core/transposition_table.h"
+
+using namespace tfe::core;
+
+// Autoplay latency with the transposition table cleared every move, with entries carried over
+// between moves (generational aging), and with symmetry-canonical keys on top. Every mode
+// searches the same sequence of positions; "same move" counts the positions where a mode picks
+// the move the clearing search picks.
+struct Run {
+    std::vector<double> ms;
+    std::vector<Direction> moves;
+    TranspositionTable::Stats stats;
+};
+
+static Run searchAll(const std::vector<Board>& positions, const int depth, const SearchOptions& options) {
+    TranspositionTable& tt = TranspositionTable::instance();
+    tt.clear();
+    tt.resetStats();
+    Run run;
+    for (const Board& board : positions) {
+        const auto start = std::chrono::steady_clock::now();
+        run.moves.push_back(AISolver::findBestMove(board, depth, options));
+        run.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    run.stats = tt.stats();
+    return run;
+}
+
+static void report(const char* name, Run run, const Run& baseline) {
+    std::size_t same = 0;
+    for (std::size_t i = 0; i < run.moves.size(); ++i) same += run.moves[i] == baseline.moves[i];
+    std::sort(run.ms.begin(), run.ms.end());
+    double total = 0;
+    for (const double ms : run.ms) total += ms;
+    const auto pct = [&](const double p) { return run.ms[static_cast<std::size_t>(p * static_cast<double>(run.ms.size() - 1))]; };
+    // Every stored entry is one expanded chance node
+    std::printf("%-10s  hit rate %5.1f%%   chance nodes %10llu   mean %7.2f   p50 %7.2f   p95 %7.2f   max %7.2f  (ms/move)   same move %zu/%zu\n",
+                name, 100.0 * run.stats.hitRate(), static_cast<unsigned long long>(run.stats.stores), total / static_cast<double>(run.ms.size()),
+                pct(0.5), pct(0.95), run.ms.back(), same, run.moves.size());
+}
+
+int main(int argc, char** argv) {
+    const int moves = argc > 1 ? std::stoi(argv[1]) : 300;
+    const int depth = argc > 2 ? std::stoi(argv[2]) : 4;
+
+    // No time budget: latency is the cost of the full iterative deepening to `depth`
+    SearchOptions options;
+    options.timeLimitMs = 0;
+
+    // One seeded autoplay game; both modes search its positions in order
+    std::vector<Board> positions;
+    Board board(4, 1);
+    while (static_cast<int>(positions.size()) < moves && !board.isGameOver()) {
+        positions.push_back(board);
+        board.move(AISolver::findBestMove(board, 2, options));
+    }
+
+    std::printf("positions=%zu depth=%d table=%zu MB\n", positions.size(), depth, TranspositionTable::instance().sizeBytes() >> 20);
+    SearchOptions clearing = options;
+    clearing.reuseTable = false;
+    const Run cleared = searchAll(positions, depth, clearing);
+    report("clear", cleared, cleared);
+    report("reuse", searchAll(positions, depth, options), cleared);
+    SearchOptions symmetric = options;
+    symmetric.symmetricKeys = true;
+    report("reuse+sym", searchAll(positions, depth, symmetric), cleared);
+    return 0;
+}
@@ -1,92 +1,344 @@
 #include "ai_solver.h"
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <cmath>
 #include <limits>
 
+#include "bitboard.h"
 #include "config.h"
+#include "leaf_eval.h"
 #include "lookup_table.h"
+#include "move_kernel.h"
+#include "ntuple_network.h"
+#include "opening_book.h"
 #include "transposition_table.h"
+#include "utils/thread-pool.h"
 
 namespace tfe::core {
 
-    // Helper: Transpose (copied from board.cpp)
-    static inline Bitboard transpose64(const Bitboard x) {
-        const Bitboard a1 = x & 0xF0F00F0FF0F00F0FULL;
-        const Bitboard a2 = x & 0x0000F0F00000F0F0ULL;
-        const Bitboard a3 = x & 0x0F0F00000F0F0000ULL;
-        const Bitboard a = a1 | (a2 << 12) | (a3 >> 12);
-        const Bitboard b1 = a & 0xFF00FF0000FF00FFULL;
-        const Bitboard b2 = a & 0x00FF00FF00000000ULL;
-        const Bitboard b3 = a & 0x00000000FF00FF00ULL;
-        return b1 | (b2 >> 24) | (b3 << 24);
+    // Evaluate board based on LookupTable (trained weights)
+    float AISolver::evaluateBoard(const Bitboard board) { return evaluateLeaf(board); }
+
+    // Nodes a thread visits between two looks at the clock and the shared node counter
+    static constexpr uint32_t NODE_CHECK_INTERVAL = 1024;
+
+    // Nodes visited by this thread since it last added them to SearchContext::nodes
+    static thread_local uint32_t tlsPendingNodes = 0;
+
+#if defined(TFE_SEARCH_STATS)
+    static constexpr bool COUNT_NODE_TYPES = true;
+#else
+    static constexpr bool COUNT_NODE_TYPES = false;
+#endif
+
+    // Per-thread SearchStats breakdown, added to SearchContext together with tlsPendingNodes
+    struct NodeCounters {
+        uint64_t chance = 0;
+        uint64_t max = 0;
+        uint64_t cutoffs = 0;
+        uint64_t star = 0;
+    };
+    static thread_local NodeCounters tlsCounters;
+
+    // Sets the calling thread's pending counts aside for one task or search and puts them back when it ends. Pools
+    // are shared between searches, so a thread waiting in one search may run another's task: each must flush only
+    // its own counts into its own context.
+    struct PendingCountsScope {
+        uint32_t nodes = tlsPendingNodes;
+        NodeCounters counters = tlsCounters;
+
+        PendingCountsScope() {
+            tlsPendingNodes = 0;
+            tlsCounters = {};
+        }
+        ~PendingCountsScope() {
+            tlsPendingNodes = nodes;
+            tlsCounters = counters;
+        }
+        PendingCountsScope(const PendingCountsScope&) = delete;
+        PendingCountsScope& operator=(const PendingCountsScope&) = delete;
+    };
+
+    // SplitMix64 finalizer: spreads (seed, board, depth) into independent-looking sampling streams
+    static uint64_t mix64(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
     }
 
-    // Helper: Count empty cells (to optimize probabilities)
-    static int countEmpty(const Bitboard board) {
-        int count = 0;
-        for (int i = 0; i < 16; ++i) {
-            if (((board >> (i * 4)) & 0xF) == 0) count++;
+    // Per-search state shared by every node and thread of one findBestMove call
+    struct AISolver::SearchContext {
+        tfe::utils::ThreadPool* pool = nullptr;  // Null: sequential search
+        bool symmetricKeys = false;
+        float probCutoff = 0.0001f;
+        int sampleSpawns = 0;
+        int sampleFromPly = 0;
+        uint64_t sampleSeed = 0;
+        float skipFoursBelowProb = 0.0f;
+        const NTupleNetwork* evaluator = nullptr;  // Null: heuristic table
+        TranspositionTable* tt = nullptr;
+        bool starPruning = false;
+        float starMargin = 0;      // Subtracted from the bar at max nodes: cut values stay clear of the best one despite rounding
+        float starUpper[16] = {};  // [t]: bound on every leaf whose biggest tile has exponent t or more
+        int iterationDepth = 0;  // Depth of the running iterative-deepening iteration
+        SearchLimits::Clock::time_point deadline = SearchLimits::Clock::time_point::max();
+        uint64_t maxNodes = 0;
+
+        // Written every NODE_CHECK_INTERVAL nodes and at the end of every task; once aborted is set every
+        // node unwinds without storing
+        mutable std::atomic<uint64_t> nodes{0};
+        mutable std::atomic<bool> aborted{false};
+        mutable std::atomic<uint64_t> chanceNodes{0};
+        mutable std::atomic<uint64_t> maxNodeCount{0};
+        mutable std::atomic<uint64_t> probCutoffs{0};
+        mutable std::atomic<uint64_t> starCutoffs{0};
+
+        // Transposition table key of a chance node
+        Bitboard key(const Bitboard board) const { return symmetricKeys ? canonicalBoard(board) : board; }
+
+        // Bound on every value below the chance node @p board, whatever the depth: tiles never shrink, so every leaf
+        // keeps a biggest tile at least as big as the board's.
+        float upperBound(const Bitboard board) const {
+            int top = 0;
+            for (Bitboard x = board; x != 0; x >>= 4) top = std::max(top, static_cast<int>(x & 0xF));
+            return starUpper[top];
+        }
+
+        // Empty cells a chance node expands: all of them, or sampleSpawns distinct cells drawn from a stream
+        // seeded by (sampleSeed, board, depth), so equal nodes always draw the same cells
+        uint64_t spawnCells(const Bitboard board, const int depth, uint64_t empty) const {
+            int count = std::popcount(empty);
+            if (sampleSpawns == 0 || count <= sampleSpawns || iterationDepth - depth < sampleFromPly) return empty;
+            uint64_t state = mix64(sampleSeed ^ board) + static_cast<uint64_t>(depth);
+            uint64_t picked = 0;
+            for (int i = 0; i < sampleSpawns; ++i, --count) {
+                state = mix64(state + 0x9E3779B97F4A7C15ULL);
+                const uint64_t cell = uint64_t{1} << selectEmptyCell(empty, static_cast<int>(((state >> 32) * static_cast<uint64_t>(count)) >> 32));
+                picked |= cell;
+                empty &= ~cell;
+            }
+            return picked;
         }
-        return count;
+
+        // A network is trained on afterstates (boards right after a slide), so a leaf is valued through its best
+        // move: reward plus the afterstate value; 0 when no move is left
+        float evaluate(const Bitboard board) const {
+            if (!evaluator) return evaluateBoard(board);
+            const MoveSet moves = computeMoves(board);
+            float best = 0;
+            for (uint8_t legal = moves.legal; legal != 0; legal &= legal - 1) {
+                const int dir = std::countr_zero(legal);
+                best = std::max(best, static_cast<float>(moves.reward[dir]) + evaluator->evaluate(moves.after[dir]));
+            }
+            return best;
+        }
+
+        // A network estimates the score still to come, so a line is worth its merges plus its leaf; the heuristic
+        // table is on its own scale and ignores them
+        float moveReward(const MoveSet& moves, const int dir) const { return evaluator ? static_cast<float>(moves.reward[dir]) : 0.0f; }
+
+        void evaluateBatch(const Bitboard* boards, float* values, const std::size_t count) const {
+            if (!evaluator) {
+                evaluateLeaves(boards, values, count);
+                return;
+            }
+            for (std::size_t i = 0; i < count; ++i) values[i] = evaluate(boards[i]);
+        }
+
+        // Counts @p count nodes; true once the search has to unwind
+        bool visit(const uint32_t count = 1) const {
+            if ((tlsPendingNodes += count) >= NODE_CHECK_INTERVAL) checkLimits();
+            return aborted.load(std::memory_order_relaxed);
+        }
+
+        void checkLimits() const {
+            const uint64_t total = flush();
+            if ((maxNodes != 0 && total >= maxNodes) || SearchLimits::Clock::now() >= deadline) aborted.store(true, std::memory_order_relaxed);
+        }
+
+        // Adds this thread's pending counts to the shared totals; returns the node total
+        uint64_t flush() const {
+            const uint64_t total = nodes.fetch_add(tlsPendingNodes, std::memory_order_relaxed) + tlsPendingNodes;
+            tlsPendingNodes = 0;
+            if constexpr (COUNT_NODE_TYPES) {
+                chanceNodes.fetch_add(tlsCounters.chance, std::memory_order_relaxed);
+                maxNodeCount.fetch_add(tlsCounters.max, std::memory_order_relaxed);
+                probCutoffs.fetch_add(tlsCounters.cutoffs, std::memory_order_relaxed);
+                starCutoffs.fetch_add(tlsCounters.star, std::memory_order_relaxed);
+                tlsCounters = {};
+            }
+            return total;
+        }
+
+        // TaskGroup::run() that flushes the task's counts when it ends, so totals are exact after wait()
+        template <typename F>
+        void fork(tfe::utils::TaskGroup& group, F&& f) const {
+            group.run([this, fn = std::forward<F>(f)]() mutable {
+                const PendingCountsScope scope;
+                fn();
+                flush();
+            });
+        }
+    };
+
+    // Chance layers below the root that are still split into tasks; deeper subtrees run sequentially
+    static constexpr int PARALLEL_SPLIT_LAYERS = 2;
+
+    Direction AISolver::findBestMove(const Board& board, const int depth, const SearchOptions& options) {
+        // Thinking time per move: options.timeLimitMs (200ms by default)
+        // Long enough to think carefully, fast enough not to lag
+        return searchRoot(board.getState().board, SearchLimits::withTimeBudget(options.timeLimitMs, depth), options, nullptr);
     }
 
-    // Evaluate board based on LookupTable (trained weights)
-    float AISolver::evaluateBoard(const Bitboard board) {
-        // Evaluate 4 horizontal rows
-        float score = LookupTable::heuristicTable[(board >> 0) & 0xFFFF] + LookupTable::heuristicTable[(board >> 16) & 0xFFFF] +
-                      LookupTable::heuristicTable[(board >> 32) & 0xFFFF] + LookupTable::heuristicTable[(board >> 48) & 0xFFFF];
+    Direction AISolver::findBestMove(const Board& board, const SearchLimits& limits, const SearchOptions& options, SearchStats* stats) {
+        return searchRoot(board.getState().board, limits, options, stats);
+    }
 
-        // Evaluate 4 vertical columns (Transpose)
-        const Bitboard t = transpose64(board);
-        score += LookupTable::heuristicTable[(t >> 0) & 0xFFFF] + LookupTable::heuristicTable[(t >> 16) & 0xFFFF] + LookupTable::heuristicTable[(t >> 32) & 0xFFFF] +
-                 LookupTable::heuristicTable[(t >> 48) & 0xFFFF];
+    SearchLimits AISolver::planSearch(const Board& board, const int budgetMs) {
+        const Bitboard state = board.getState().board;
+        const int empty = countEmpty(state);
+        uint32_t values = 0;
+        for (int i = 0; i < 16; ++i) values |= 1u << ((state >> (i * 4)) & 0xF);
+        const int distinct = std::popcount(values & ~1u);
 
-        return score;
+        // Danger tiers by free cells: {min empty, time share, probability cutoff, depth cap}
+        struct Tier {
+            int minEmpty;
+            float timeShare;
+            float probCutoff;
+            int maxDepth;
+        };
+        static constexpr Tier TIERS[] = {
+            {6, 0.2f, 0.005f, 2},   // Open: almost any move is safe
+            {4, 0.4f, 0.001f, 3},
+            {2, 0.7f, 0.0002f, 5},
+            {0, 1.3f, 0.0001f, 8},  // One or two wrong spawns from death
+        };
+        const Tier& tier = *std::find_if(std::begin(TIERS), std::end(TIERS), [&](const Tier& t) { return empty >= t.minEmpty; });
+
+        const int timeMs = budgetMs > 0 ? std::max(1, static_cast<int>(static_cast<float>(budgetMs) * tier.timeShare)) : 0;
+        SearchLimits limits = SearchLimits::withTimeBudget(timeMs, 0);
+        limits.maxDepth = std::clamp(distinct - 2, 2, tier.maxDepth);
+        limits.probCutoff = tier.probCutoff;
+        return limits;
     }
 
-    Direction AISolver::findBestMove(const Board& board, const int depth) {
-        const Bitboard currentBoard = board.getState().board;
-        auto bestMove = Direction::Up;
+    Direction AISolver::searchRoot(const Bitboard currentBoard, const SearchLimits& limits, const SearchOptions& options, SearchStats* stats) {
+        const auto startTime = SearchLimits::Clock::now();
+        if (stats) *stats = {};
+        if (options.book) {
+            if (const auto move = options.book->probe(currentBoard)) {
+                if (stats) {
+                    stats->bookHit = true;
+                    stats->totalMs = std::chrono::duration<double, std::milli>(SearchLimits::Clock::now() - startTime).count();
+                }
+                return *move;
+            }
+        }
+        const int threads = options.threads > 0 ? options.threads : tfe::utils::ThreadPool::hardwareThreads();
+        SearchContext ctx;
+        ctx.pool = threads > 1 ? &tfe::utils::ThreadPool::shared(threads) : nullptr;
+        ctx.symmetricKeys = options.symmetricKeys;
+        ctx.probCutoff = limits.probCutoff;
+        ctx.deadline = limits.deadline;
+        ctx.maxNodes = limits.maxNodes;
+        ctx.sampleSpawns = options.sampleSpawns;
+        ctx.sampleFromPly = options.sampleFromPly;
+        ctx.sampleSeed = options.sampleSeed;
+        ctx.skipFoursBelowProb = options.skipFoursBelowProb;
+        ctx.evaluator = options.evaluator;
+        // Split root moves run side by side, so none has a bar to prune against
+        ctx.starPruning = options.starPruning && !options.evaluator && !ctx.pool;
+        if (ctx.starPruning) {
+            LookupTable::ensureInitialized();
+            // A leaf adds 4 rows and 4 columns: the row and the column holding its biggest tile c are bounded by rows
+            // with that tile, the other 6 by rows with no bigger one. A lost game is worth 0. Leaves below a board
+            // whose biggest tile is t have c >= t, so starUpper[t] is the largest of these bounds over c = t..15.
+            const float* rowMax = LookupTable::heuristicRowMax;
+            float perTop[16];
+            float any = rowMax[0];
+            for (int c = 0; c < 16; ++c) {
+                any = std::max(any, rowMax[c]);
+                perTop[c] = std::max(0.0f, 6 * any + 2 * rowMax[c]);
+            }
+            float upper = 0;
+            for (int t = 15; t >= 0; --t) ctx.starUpper[t] = upper = std::max(upper, perTop[t]);
+            // Far above the rounding of sums of a few dozen values of this magnitude
+            ctx.starMargin = 1e-4f * 8 * std::max(std::fabs(*std::max_element(rowMax, rowMax + 16)), std::fabs(LookupTable::heuristicRowMin));
+        }
+        const PendingCountsScope pendingCounts;  // Every iteration ends with ctx.flush(), so nothing is left behind
 
-        // Thinking time per move: 200ms
-        // Long enough to think carefully, fast enough not to lag
-        const auto startTime = std::chrono::high_resolution_clock::now();
+        // The table has a fixed size; only reallocate when a different budget is requested
+        TranspositionTable& tt = options.table ? *options.table : TranspositionTable::instance();
+        ctx.tt = &tt;
+        if (options.ttSizeMb != 0 && options.ttSizeMb != tt.configuredMegabytes()) tt.resize(options.ttSizeMb);
+        // The previous move's search already covered most of this tree: keep it, aged by one generation
+        // Values of another evaluator or of reloaded/requantized weights are on another scale: never mix them.
+        // Sampled values are estimates: within one search a node only reads entries from plies sampled no more
+        // than its own, but the next move's plies shift by one, so a sparse search neither reuses nor leaves entries.
+        const bool sampled = options.sampleSpawns > 0;
+        const uint64_t contentTag = mix64(reinterpret_cast<std::uintptr_t>(options.evaluator)) ^ mix64(2 * uint64_t{LookupTable::weightsEpoch} + sampled);
+        if (tt.exchangeContentTag(contentTag) == contentTag && !sampled && options.reuseTable) tt.newSearch();
+        else tt.clear();
+        const TranspositionTable::Stats ttBefore = tt.stats();
+
+        // The root afterstates don't change between iterations
+        const MoveSet rootMoves = computeMoves(currentBoard);
 
-        // Clear old cache to prevent memory overflow (optional)
-        TranspositionTable::instance().clear();
+        // Fallback if even the first iteration is aborted
+        auto bestMove = rootMoves.legal != 0 ? static_cast<Direction>(std::countr_zero(rootMoves.legal)) : Direction::Up;
 
-        for (int dth = 1; dth <= depth; ++dth) {
+        for (int dth = 1; dth <= limits.maxDepth; ++dth) {
+            const auto iterationStart = SearchLimits::Clock::now();
+            const uint64_t nodesBefore = ctx.nodes.load(std::memory_order_relaxed);
+            ctx.iterationDepth = dth;
             float currentBestScore = -std::numeric_limits<float>::max();
             auto currentBestMove = Direction::Up;
             bool foundMove = false;
 
-            // Try 4 directions at the current depth
-            for (constexpr Direction dirs[4] = {Direction::Up, Direction::Down, Direction::Left, Direction::Right}; const auto dir : dirs) {
-                Bitboard nextBoard = currentBoard;
-                bool changed = false;
-
-                // Logic giả lập di chuyển (Move Simulation)
-                const bool needTranspose = (dir == Direction::Up || dir == Direction::Down);
-                if (needTranspose) nextBoard = transpose64(nextBoard);
-                Bitboard tempBoard = 0;
-                for (int r = 0; r < 4; ++r) {
-                    const Row row = (nextBoard >> (r * 16)) & Config::ROW_MASK;
-                    Row newRow;
-                    if (dir == Direction::Left || dir == Direction::Up)
-                        newRow = LookupTable::moveLeftTable[row];
-                    else
-                        newRow = LookupTable::moveRightTable[row];
-                    tempBoard |= (static_cast<Bitboard>(newRow) << (r * 16));
+            // Score the 4 directions at the current depth (one task each in parallel mode)
+            float scores[4] = {};
+            if (ctx.pool) {
+                tfe::utils::TaskGroup group(*ctx.pool);
+                for (int d = 0; d < 4; ++d) {
+                    if ((rootMoves.legal >> d) & 1) {
+                        ctx.fork(group, [&, d] { scores[d] = expectimaxParallel(ctx, rootMoves.after[d], dth, false, 1.0f, PARALLEL_SPLIT_LAYERS); });
+                    }
+                }
+                group.wait();
+            } else if (ctx.starPruning) {
+                // Same move order as below, so the table fills the same way. Cut moves come back below the best
+                // score so far, so the selection below still sees every contender's exact score.
+                float best = -std::numeric_limits<float>::infinity();
+                for (int d = 0; d < 4; ++d) {
+                    if (!((rootMoves.legal >> d) & 1)) continue;
+                    bool exact = true;
+                    scores[d] = expectimaxStar(ctx, rootMoves.after[d], dth, false, 1.0f, best - ctx.starMargin, exact);
+                    if (exact) best = std::max(best, scores[d]);
                 }
-                if (tempBoard != nextBoard) changed = true;
-                nextBoard = tempBoard;
-                if (needTranspose) nextBoard = transpose64(nextBoard);
-                // ----------------------------------------
-
-                if (changed) {
-                    // Recursive call
-                    if (const float score = expectimax(nextBoard, dth, false, 1.0f); score > currentBestScore) {
+            } else {
+                for (int d = 0; d < 4; ++d) {
+                    if ((rootMoves.legal >> d) & 1) scores[d] = expectimax(ctx, rootMoves.after[d], dth, false, 1.0f);
+                }
+            }
+            ctx.flush();
+            for (int d = 0; d < 4; ++d) scores[d] += ctx.moveReward(rootMoves, d);
+
+            const bool aborted = ctx.aborted.load(std::memory_order_relaxed);
+            if (stats) {
+                const double ms = std::chrono::duration<double, std::milli>(SearchLimits::Clock::now() - iterationStart).count();
+                stats->iterations.push_back({dth, ctx.nodes.load(std::memory_order_relaxed) - nodesBefore, ms, !aborted});
+            }
+
+            // A partial iteration is not comparable across moves: keep the last completed one
+            if (aborted) break;
+
+            for (constexpr Direction dirs[4] = {Direction::Up, Direction::Down, Direction::Left, Direction::Right}; const auto dir : dirs) {
+                if (isLegal(rootMoves, dir)) {
+                    if (const float score = scores[static_cast<int>(dir)]; score > currentBestScore) {
                         currentBestScore = score;
                         currentBestMove = dir;
                         foundMove = true;
@@ -99,86 +351,436 @@ namespace tfe::core {
                 bestMove = currentBestMove;
             }
 
-            // Check time: If over 200ms, stop immediately and return the best available result
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - startTime).count();
-            if (constexpr long long timeLimitMs = 200; duration > timeLimitMs) {
+            // Check time: If over budget, stop immediately and return the best available result
+            if (SearchLimits::Clock::now() >= limits.deadline) {
                 break;
             }
         }
 
+        if (stats) {
+            int depthReached = 0;
+            for (const auto& iteration : stats->iterations) {
+                if (iteration.completed) depthReached = iteration.depth;
+            }
+            stats->depthReached = depthReached;
+            stats->aborted = ctx.aborted.load(std::memory_order_relaxed);
+            stats->totalMs = std::chrono::duration<double, std::milli>(SearchLimits::Clock::now() - startTime).count();
+            stats->nodes = ctx.nodes.load(std::memory_order_relaxed);
+            stats->chanceNodes = ctx.chanceNodes.load(std::memory_order_relaxed);
+            stats->maxNodes = ctx.maxNodeCount.load(std::memory_order_relaxed);
+            stats->probCutoffs = ctx.probCutoffs.load(std::memory_order_relaxed);
+            stats->starCutoffs = ctx.starCutoffs.load(std::memory_order_relaxed);
+            const TranspositionTable::Stats ttAfter = tt.stats();
+            stats->ttProbes = ttAfter.probes - ttBefore.probes;
+            stats->ttHits = ttAfter.hits - ttBefore.hits;
+            stats->ttStores = ttAfter.stores - ttBefore.stores;
+            stats->ttBytes = tt.sizeBytes();
+        }
+
         return bestMove;
     }
 
-    float AISolver::expectimax(const Bitboard board, const int depth, const bool isPlayerTurn, const float cumulativeProb) {
-        if (cumulativeProb < 0.0001f || depth == 0) {
-            return evaluateBoard(board);
+    float AISolver::expectimax(const SearchContext& ctx, const Bitboard board, const int depth, const bool isPlayerTurn, const float cumulativeProb) {
+        if (ctx.visit()) return 0;  // Aborted: every caller discards the value
+
+        if (cumulativeProb < ctx.probCutoff || depth == 0) {
+            if constexpr (COUNT_NODE_TYPES) tlsCounters.cutoffs += depth != 0;
+            return ctx.evaluate(board);
         }
+        if constexpr (COUNT_NODE_TYPES) ++(isPlayerTurn ? tlsCounters.max : tlsCounters.chance);
 
         // CHANCE NODE: Only cache computer's turn (spawning tiles) because this state repeats most often
+        const Bitboard key = isPlayerTurn ? board : ctx.key(board);
         if (!isPlayerTurn) {
-            if (float cachedScore; TranspositionTable::instance().get(board, depth, cachedScore)) {  // Check if already computed
+            if (float cachedScore; ctx.tt->get(key, depth, cachedScore)) {  // Check if already computed
                 return cachedScore;
             }
         }
 
         if (isPlayerTurn) {  // Max Node (Lượt người chơi)
-            float maxVal = -std::numeric_limits<float>::max();
-            bool canMove = false;
+            const MoveSet moves = computeMoves(board);
+            if (moves.legal == 0) return 0;  // Heavy penalty if no moves are possible
 
+            float maxVal = -std::numeric_limits<float>::max();
             for (int dir = 0; dir < 4; ++dir) {
-                Bitboard nextBoard = board;
-                const bool needTranspose = (dir == 0 || dir == 1);  // Up/Down
-                if (needTranspose) nextBoard = transpose64(nextBoard);
-
-                Bitboard tempBoard = 0;
-                for (int r = 0; r < 4; ++r) {
-                    const Row row = (nextBoard >> (r * 16)) & 0xFFFF;
-                    Row newRow;
-                    if (dir == 0 || dir == 2)
-                        newRow = LookupTable::moveLeftTable[row];
-                    else
-                        newRow = LookupTable::moveRightTable[row];
-                    tempBoard |= (static_cast<Bitboard>(newRow) << (r * 16));
-                }
-
-                const bool changed = (tempBoard != nextBoard);
-                nextBoard = tempBoard;
-                if (needTranspose) nextBoard = transpose64(nextBoard);
-
-                if (changed) {
-                    canMove = true;
+                if ((moves.legal >> dir) & 1) {
                     // Keep depth for Chance node
-                    if (const float val = expectimax(nextBoard, depth, false, cumulativeProb); val > maxVal) maxVal = val;
+                    const float val = ctx.moveReward(moves, dir) + expectimax(ctx, moves.after[dir], depth, false, cumulativeProb);
+                    if (val > maxVal) maxVal = val;
                 }
             }
-            return canMove ? maxVal : 0;  // Heavy penalty if no moves are possible
+            return maxVal;
         }
 
         // Chance Node (Computer's turn)
         float totalScore = 0;
-        const int emptyCount = countEmpty(board);
-        if (emptyCount == 0) return evaluateBoard(board);
+        const uint64_t empty = emptyMask(board);
+        if (empty == 0) return ctx.evaluate(board);
+        // Every empty cell, or the sampled subset (sparse mode); the average over them estimates the node
+        const uint64_t spawns = ctx.spawnCells(board, depth, empty);
+        const int emptyCount = std::popcount(spawns);
+        const bool withFours = cumulativeProb >= ctx.skipFoursBelowProb;
+
+        // Last layer: every child is a leaf, so evaluate them as one batch
+        if (depth == 1) {
+            Bitboard leaves[32];
+            float values[32];
+            int count = 0;
+            for (uint64_t cells = spawns; cells != 0; cells &= cells - 1) {
+                const int shift = std::countr_zero(cells);
+                leaves[count++] = board | (static_cast<Bitboard>(1) << shift);
+                if (withFours) leaves[count++] = board | (static_cast<Bitboard>(2) << shift);
+            }
+            if (ctx.visit(static_cast<uint32_t>(count))) return 0;
+            ctx.evaluateBatch(leaves, values, static_cast<std::size_t>(count));
+
+            // Same weights and summation order as the loop below
+            for (int i = 0; i < count;) {
+                if (!withFours) {
+                    totalScore += values[i++];
+                    continue;
+                }
+                totalScore += 0.9f * values[i++];
+                totalScore += 0.1f * values[i++];
+            }
+        } else {
+            // We separate cumulativeProb from the cached value
+            // The cached value must be the "pure average score" of the board state
+            for (uint64_t cells = spawns; cells != 0; cells &= cells - 1) {
+                const int shift = std::countr_zero(cells);
+                const Bitboard board2 = board | (static_cast<Bitboard>(1) << shift);
+                if (!withFours) {  // Unlikely branch: the 2 spawn stands for the cell
+                    totalScore += expectimax(ctx, board2, depth - 1, true, cumulativeProb * 0.9f);
+                    continue;
+                }
 
-        // We separate cumulativeProb from the cached value
-        // The cached value must be the "pure average score" of the board state
-        for (int i = 0; i < 16; ++i) {
-            if (((board >> (i * 4)) & 0xF) == 0) {
                 // Spawn tile 2 (0.9 probability)
-                const Bitboard board2 = board | (static_cast<Bitboard>(1) << (i * 4));
-                totalScore += 0.9f * expectimax(board2, depth - 1, true, cumulativeProb * 0.9f);
+                totalScore += 0.9f * expectimax(ctx, board2, depth - 1, true, cumulativeProb * 0.9f);
 
                 // Spawn tile 4 (0.1 probability)
-                const Bitboard board4 = board | (static_cast<Bitboard>(2) << (i * 4));
-                totalScore += 0.1f * expectimax(board4, depth - 1, true, cumulativeProb * 0.1f);
+                const Bitboard board4 = board | (static_cast<Bitboard>(2) << shift);
+                totalScore += 0.1f * expectimax(ctx, board4, depth - 1, true, cumulativeProb * 0.1f);
             }
         }
 
+        // Children may have unwound with placeholder values
+        if (ctx.aborted.load(std::memory_order_relaxed)) return 0;
+
         const float finalScore = totalScore / static_cast<float>(emptyCount);
 
         // Store in cache for reuse
-        TranspositionTable::instance().put(board, depth, finalScore);
+        ctx.tt->put(key, depth, finalScore);
+
+        return finalScore;
+    }
+
+    float AISolver::expectimaxParallel(const SearchContext& ctx, const Bitboard board, const int depth, const bool isPlayerTurn, const float cumulativeProb,
+                                       const int splitLayers) {
+        // Small subtrees are cheaper to search than to schedule
+        if (splitLayers == 0 || depth <= 1 || cumulativeProb < ctx.probCutoff) {
+            return expectimax(ctx, board, depth, isPlayerTurn, cumulativeProb);
+        }
+        if (ctx.visit()) return 0;
+        if constexpr (COUNT_NODE_TYPES) ++(isPlayerTurn ? tlsCounters.max : tlsCounters.chance);
 
+        if (isPlayerTurn) {  // Max Node: one task per legal move
+            const MoveSet moves = computeMoves(board);
+            if (moves.legal == 0) return 0;
+
+            float values[4];
+            {
+                tfe::utils::TaskGroup group(*ctx.pool);
+                for (int dir = 0; dir < 4; ++dir) {
+                    if ((moves.legal >> dir) & 1) {
+                        ctx.fork(group, [&, dir] { values[dir] = expectimaxParallel(ctx, moves.after[dir], depth, false, cumulativeProb, splitLayers); });
+                    }
+                }
+            }
+            float maxVal = -std::numeric_limits<float>::max();
+            for (int dir = 0; dir < 4; ++dir) {
+                if (!((moves.legal >> dir) & 1)) continue;
+                if (const float val = values[dir] + ctx.moveReward(moves, dir); val > maxVal) maxVal = val;
+            }
+            return maxVal;
+        }
+
+        // Chance Node: one task per spawn (cell x {2, 4})
+        const Bitboard key = ctx.key(board);
+        if (float cachedScore; ctx.tt->get(key, depth, cachedScore)) {
+            return cachedScore;
+        }
+        const uint64_t empty = emptyMask(board);
+        if (empty == 0) return ctx.evaluate(board);
+        const uint64_t spawns = ctx.spawnCells(board, depth, empty);
+        const int emptyCount = std::popcount(spawns);
+        const bool withFours = cumulativeProb >= ctx.skipFoursBelowProb;
+
+        float values2[16], values4[16];
+        {
+            tfe::utils::TaskGroup group(*ctx.pool);
+            int i = 0;
+            for (uint64_t cells = spawns; cells != 0; cells &= cells - 1, ++i) {
+                const int shift = std::countr_zero(cells);
+                ctx.fork(group, [&, i, shift] {
+                    values2[i] = expectimaxParallel(ctx, board | (static_cast<Bitboard>(1) << shift), depth - 1, true, cumulativeProb * 0.9f, splitLayers - 1);
+                });
+                if (!withFours) continue;
+                ctx.fork(group, [&, i, shift] {
+                    values4[i] = expectimaxParallel(ctx, board | (static_cast<Bitboard>(2) << shift), depth - 1, true, cumulativeProb * 0.1f, splitLayers - 1);
+                });
+            }
+        }
+
+        if (ctx.aborted.load(std::memory_order_relaxed)) return 0;
+
+        // Same summation order as expectimax()
+        float totalScore = 0;
+        for (int i = 0; i < emptyCount; ++i) {
+            if (!withFours) {
+                totalScore += values2[i];
+                continue;
+            }
+            totalScore += 0.9f * values2[i];
+            totalScore += 0.1f * values4[i];
+        }
+        const float finalScore = totalScore / static_cast<float>(emptyCount);
+        ctx.tt->put(key, depth, finalScore);
         return finalScore;
     }
+
+    float AISolver::expectimaxStar(const SearchContext& ctx, const Bitboard board, const int depth, const bool isPlayerTurn, const float cumulativeProb,
+                                   const float alpha, bool& exact) {
+        exact = true;
+        if (ctx.visit()) return 0;  // Aborted: every caller discards the value
+
+        if (cumulativeProb < ctx.probCutoff || depth == 0) {
+            if constexpr (COUNT_NODE_TYPES) tlsCounters.cutoffs += depth != 0;
+            return ctx.evaluate(board);
+        }
+        if constexpr (COUNT_NODE_TYPES) ++(isPlayerTurn ? tlsCounters.max : tlsCounters.chance);
+
+        if (isPlayerTurn) {  // Max Node: each move must beat alpha and the moves before it, less the margin
+            const MoveSet moves = computeMoves(board);
+            if (moves.legal == 0) return 0;
+
+            float best = -std::numeric_limits<float>::infinity();
+            float bound = -std::numeric_limits<float>::infinity();
+            bool allExact = true;
+            for (int dir = 0; dir < 4; ++dir) {
+                if (!((moves.legal >> dir) & 1)) continue;
+                bool childExact = true;
+                const float val = expectimaxStar(ctx, moves.after[dir], depth, false, cumulativeProb, std::max(alpha, best) - ctx.starMargin, childExact);
+                if (childExact) best = std::max(best, val);
+                else bound = std::max(bound, val);
+                allExact &= childExact;
+            }
+            // Cut moves ended a margin below max(alpha, best): once best reaches alpha, none of them is the max
+            exact = allExact || best >= alpha;
+            return exact ? best : std::max(best, bound);
+        }
+
+        // Chance Node. An exact entry answers as in expectimax(); a transposition cut before may be settled by its bound
+        TranspositionTable& tt = *ctx.tt;
+        const Bitboard key = ctx.key(board);
+        if (float cachedScore; tt.get(key, depth, cachedScore)) {
+            return cachedScore;
+        }
+        float bound;
+        const bool hasBound = tt.getUpperBound(key, depth, bound);
+        const uint64_t empty = emptyMask(board);
+        if (empty == 0) return ctx.evaluate(board);
+        const uint64_t spawns = ctx.spawnCells(board, depth, empty);
+        const int emptyCount = std::popcount(spawns);
+        const bool withFours = cumulativeProb >= ctx.skipFoursBelowProb;
+
+        // Star1: the spawns not searched yet are worth at most `upper` each, so the node is cut (returning that
+        // upper bound) as soon as the weighted sum can no longer reach alpha * emptyCount
+        const float upper = ctx.upperBound(board);
+        if (upper < alpha) {
+            if constexpr (COUNT_NODE_TYPES) ++tlsCounters.star;
+            exact = false;
+            return upper;
+        }
+        if (hasBound && bound < alpha) {
+            if constexpr (COUNT_NODE_TYPES) ++tlsCounters.star;
+            exact = false;
+            return bound;
+        }
+        const float target = alpha * static_cast<float>(emptyCount);
+        const auto cut = [&](const float boundSum) {
+            if constexpr (COUNT_NODE_TYPES) ++tlsCounters.star;
+            exact = false;
+            if (ctx.aborted.load(std::memory_order_relaxed)) return 0.0f;
+            const float value = boundSum / static_cast<float>(emptyCount);
+            tt.putUpperBound(key, depth, value);
+            return value;
+        };
+
+        float totalScore = 0;
+        if (depth == 1) {
+            // Leaves are evaluated as one batch, as in expectimax()
+            Bitboard leaves[32];
+            float values[32];
+            int count = 0;
+            for (uint64_t cells = spawns; cells != 0; cells &= cells - 1) {
+                const int shift = std::countr_zero(cells);
+                leaves[count++] = board | (static_cast<Bitboard>(1) << shift);
+                if (withFours) leaves[count++] = board | (static_cast<Bitboard>(2) << shift);
+            }
+            if (ctx.visit(static_cast<uint32_t>(count))) return 0;
+            ctx.evaluateBatch(leaves, values, static_cast<std::size_t>(count));
+            for (int i = 0; i < count;) {
+                if (!withFours) {
+                    totalScore += values[i++];
+                    continue;
+                }
+                totalScore += 0.9f * values[i++];
+                totalScore += 0.1f * values[i++];
+            }
+        } else {
+            // Same terms in the same order as expectimax(); a child that was cut lets its bound through and cuts this node
+            int cellsLeft = emptyCount;
+            for (uint64_t cells = spawns; cells != 0; cells &= cells - 1) {
+                const int shift = std::countr_zero(cells);
+                --cellsLeft;
+                bool childExact = true;
+
+                const float weight2 = withFours ? 0.9f : 1.0f;
+                float rest = static_cast<float>(cellsLeft) * upper + (withFours ? 0.1f * upper : 0.0f);
+                const float value2 = expectimaxStar(ctx, board | (static_cast<Bitboard>(1) << shift), depth - 1, true, cumulativeProb * 0.9f,
+                                                    (target - totalScore - rest) / weight2, childExact);
+                if (withFours) totalScore += 0.9f * value2;
+                else totalScore += value2;
+                if (!childExact || totalScore + rest < target) return cut(totalScore + rest);
+                if (!withFours) continue;
+
+                rest = static_cast<float>(cellsLeft) * upper;
+                const float value4 = expectimaxStar(ctx, board | (static_cast<Bitboard>(2) << shift), depth - 1, true, cumulativeProb * 0.1f,
+                                                    (target - totalScore - rest) / 0.1f, childExact);
+                totalScore += 0.1f * value4;
+                if (!childExact || totalScore + rest < target) return cut(totalScore + rest);
+            }
+        }
+
+        if (ctx.aborted.load(std::memory_order_relaxed)) return 0;
+
+        const float finalScore = totalScore / static_cast<float>(emptyCount);
+        tt.put(key, depth, finalScore);
+        return finalScore;
+    }
+
+    // Expectimax on SizedBoard storage: no transposition table (it is keyed by the 4x4 Bitboard)
+    template <int N>
+    static float evaluateSized(const typename SizedLayout<N>::Storage& board) {
+        using L = SizedLayout<N>;
+        float score = 0;
+        for (int i = 0; i < N; ++i) score += LineKernel<N>::heuristic(L::getRow(board, i)) + LineKernel<N>::heuristic(L::getColumn(board, i));
+        return score;
+    }
+
+    // Single-threaded counterpart of SearchContext's limits for the sized search
+    struct SizedSearch {
+        const SearchLimits& limits;
+        uint64_t nodes = 0;
+        bool aborted = false;
+
+        // Counts a node; true once the search has to unwind
+        bool visit() {
+            if (++nodes % NODE_CHECK_INTERVAL == 0 &&
+                ((limits.maxNodes != 0 && nodes >= limits.maxNodes) || SearchLimits::Clock::now() >= limits.deadline)) {
+                aborted = true;
+            }
+            return aborted;
+        }
+    };
+
+    template <int N>
+    static float expectimaxSized(SizedSearch& search, const typename SizedLayout<N>::Storage& board, const int depth, const bool isPlayerTurn,
+                                 const float cumulativeProb) {
+        using L = SizedLayout<N>;
+        if (search.visit()) return 0;  // Aborted: the caller discards the iteration
+        if (cumulativeProb < search.limits.probCutoff || depth == 0) return evaluateSized<N>(board);
+
+        if (isPlayerTurn) {
+            float maxVal = -std::numeric_limits<float>::max();
+            bool anyMove = false;
+            for (int dir = 0; dir < 4; ++dir) {
+                int reward;
+                const auto next = moveSized<N>(board, static_cast<Direction>(dir), reward);
+                if (next == board) continue;
+                anyMove = true;
+                if (const float val = expectimaxSized<N>(search, next, depth, false, cumulativeProb); val > maxVal) maxVal = val;
+            }
+            return anyMove ? maxVal : 0;
+        }
+
+        float totalScore = 0;
+        int emptyCount = 0;
+        for (int w = 0; w < L::WORDS; ++w) {
+            for (uint64_t cells = L::emptyCells(board, w); cells != 0; cells &= cells - 1) {
+                const int shift = std::countr_zero(cells);
+                auto board2 = board;
+                L::word(board2, w) |= uint64_t{1} << shift;
+                totalScore += 0.9f * expectimaxSized<N>(search, board2, depth - 1, true, cumulativeProb * 0.9f);
+                auto board4 = board;
+                L::word(board4, w) |= uint64_t{2} << shift;
+                totalScore += 0.1f * expectimaxSized<N>(search, board4, depth - 1, true, cumulativeProb * 0.1f);
+                ++emptyCount;
+            }
+        }
+        if (emptyCount == 0) return evaluateSized<N>(board);
+        return totalScore / static_cast<float>(emptyCount);
+    }
+
+    template <int N>
+    Direction AISolver::findBestMove(const SizedBoard<N>& board, const int depth, const SearchOptions& options) {
+        return findBestMove(board, SearchLimits::withTimeBudget(options.timeLimitMs, depth), options);
+    }
+
+    template <int N>
+    Direction AISolver::findBestMove(const SizedBoard<N>& board, const SearchLimits& limits, const SearchOptions& options) {
+        if constexpr (N == 4) {
+            return searchRoot(board.getState(), limits, options, nullptr);
+        } else {
+            const auto current = board.getState();
+            SizedSearch search{limits};
+
+            // Iterative deepening as in searchRoot(): an iteration cut by the limits is discarded
+            auto bestMove = Direction::Up;
+            bool fallback = true;  // Still on the first legal move, before any iteration completed
+            for (int dth = 1; dth <= limits.maxDepth; ++dth) {
+                auto currentBestMove = Direction::Up;
+                float bestScore = -std::numeric_limits<float>::max();
+                bool foundMove = false;
+                for (int dir = 0; dir < 4; ++dir) {
+                    int reward;
+                    const auto next = moveSized<N>(current, static_cast<Direction>(dir), reward);
+                    if (next == current) continue;
+                    if (fallback) {
+                        bestMove = static_cast<Direction>(dir);
+                        fallback = false;
+                    }
+                    if (const float score = expectimaxSized<N>(search, next, dth, false, 1.0f); score > bestScore) {
+                        bestScore = score;
+                        currentBestMove = static_cast<Direction>(dir);
+                        foundMove = true;
+                    }
+                }
+                if (search.aborted) break;
+                if (foundMove) bestMove = currentBestMove;
+                if (SearchLimits::Clock::now() >= limits.deadline) break;
+            }
+            return bestMove;
+        }
+    }
+
+    template Direction AISolver::findBestMove<3>(const SizedBoard<3>&, int, const SearchOptions&);
+    template Direction AISolver::findBestMove<4>(const SizedBoard<4>&, int, const SearchOptions&);
+    template Direction AISolver::findBestMove<5>(const SizedBoard<5>&, int, const SearchOptions&);
+    template Direction AISolver::findBestMove<6>(const SizedBoard<6>&, int, const SearchOptions&);
+    template Direction AISolver::findBestMove<3>(const SizedBoard<3>&, const SearchLimits&, const SearchOptions&);
+    template Direction AISolver::findBestMove<4>(const SizedBoard<4>&, const SearchLimits&, const SearchOptions&);
+    template Direction AISolver::findBestMove<5>(const SizedBoard<5>&, const SearchLimits&, const SearchOptions&);
+    template Direction AISolver::findBestMove<6>(const SizedBoard<6>&, const SearchLimits&, const SearchOptions&);
+
 }  // namespace tfe::core
\ No newline at end of file
@@ -1,19 +1,194 @@
 #pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include "board.h"
+#include "sized_board.h"
 
 namespace tfe::core {
 
+    class NTupleNetwork;
+    class OpeningBook;
+    class TranspositionTable;
+
+    /**
+     * @struct SearchLimits
+     * @brief When a search must stop. The deadline and node budget are checked inside the tree: the running
+     *        iteration is abandoned and the best move of the last completed iteration is returned.
+     */
+    struct SearchLimits {
+        using Clock = std::chrono::steady_clock;
+
+        // Wall-clock deadline (time_point::max() = none)
+        Clock::time_point deadline = Clock::time_point::max();
+
+        // Nodes to visit before aborting (0 = unlimited). Checked every few thousand nodes per thread.
+        std::uint64_t maxNodes = 0;
+
+        // Deepest iterative-deepening iteration
+        int maxDepth = 4;
+
+        // Subtrees reached with a smaller probability are evaluated statically
+        float probCutoff = 0.0001f;
+
+        // Limits with a deadline @p ms from now (0 = none)
+        static SearchLimits withTimeBudget(const int ms, const int depth) {
+            SearchLimits limits;
+            limits.maxDepth = depth;
+            if (ms > 0) limits.deadline = Clock::now() + std::chrono::milliseconds(ms);
+            return limits;
+        }
+    };
+
+    /**
+     * @struct SearchStats
+     * @brief What one findBestMove call did, filled on request.
+     *
+     * Node totals and iterations are always counted. The per-node breakdown (chance/max nodes, probability
+     * cutoffs) and the transposition table counters need a TFE_SEARCH_STATS build and read 0 otherwise.
+     * Node counts (nodes, chanceNodes, maxNodes, cutoffs) belong to this search alone, even when concurrent searches
+     * share a thread pool. The table counters are global: searches running concurrently show up in each other's numbers.
+     */
+    struct SearchStats {
+        struct Iteration {
+            int depth = 0;
+            std::uint64_t nodes = 0;
+            double ms = 0;
+            bool completed = false;  // False for the iteration cut off by the deadline/node budget
+        };
+        std::vector<Iteration> iterations;
+
+        bool bookHit = false;  // Answered by SearchOptions::book without searching (no iterations, no nodes)
+        int depthReached = 0;  // Deepest completed iteration
+        bool aborted = false;
+        double totalMs = 0;
+
+        std::uint64_t nodes = 0;        // Every node visited, leaves included
+        std::uint64_t chanceNodes = 0;  // Chance nodes reached (table hits included)
+        std::uint64_t maxNodes = 0;     // Max (player) nodes expanded
+        std::uint64_t probCutoffs = 0;  // Leaves evaluated early because their probability fell below the cutoff
+        std::uint64_t starCutoffs = 0;  // Chance nodes cut by Star1 pruning before all their spawns were searched
+
+        std::uint64_t ttProbes = 0;
+        std::uint64_t ttHits = 0;
+        std::uint64_t ttStores = 0;
+        std::size_t ttBytes = 0;
+
+        double ttHitRate() const { return ttProbes == 0 ? 0.0 : static_cast<double>(ttHits) / static_cast<double>(ttProbes); }
+    };
+
+    /**
+     * @struct SearchOptions
+     * @brief Knobs of AISolver::findBestMove.
+     */
+    struct SearchOptions {
+        // Search threads: 1 searches on the calling thread, 0 uses every hardware thread.
+        // Root moves and the top chance layers are split across a work-stealing pool sharing one transposition table.
+        int threads = 1;
+
+        // Hard time budget per move, turned into SearchLimits::deadline by findBestMove(board, depth) (0 = full depth).
+        int timeLimitMs = 200;
+
+        // Transposition table memory in MB; the table never grows past it (0 keeps the current size).
+        std::size_t ttSizeMb = 0;
+
+        // Table of this search; null shares TranspositionTable::instance() with every other search. Games played
+        // side by side each pass their own, so one game's clears and generations never touch another's entries.
+        TranspositionTable* table = nullptr;
+
+        // Keep transposition table entries from earlier moves (aged by generation) instead of clearing the table.
+        // Loading or requantizing the heuristic weights (LookupTable) clears it regardless.
+        bool reuseTable = true;
+
+        // Key chance nodes by their canonical rotation/reflection, so the 8 symmetric boards share one entry.
+        // With the built-in heuristic (symmetric rows) a shared entry matches the board's own score up to float
+        // rounding, so only near-ties can change; tt_reuse_bench counts them. Weights loaded from a file must be
+        // symmetric too.
+        bool symmetricKeys = false;
+
+        // Sparse chance nodes (sampleSpawns = 0: every empty cell is expanded). Chance nodes at least
+        // sampleFromPly chance layers below the root expand only sampleSpawns empty cells, picked from
+        // sampleSeed and the board: deterministic for one thread and one seed. Parallel searches pick the same
+        // cells but may still differ through transposition-table timing. Sampled values are estimates, so a sparse
+        // search starts from a cleared table and the search after it does too (reuseTable has no effect): no other
+        // search reads them as exact values.
+        int sampleSpawns = 0;
+        int sampleFromPly = 2;
+        std::uint64_t sampleSeed = 0;
+
+        // Below this cumulative probability only the 2 spawn of a cell is searched (0 = always search the 4 too).
+        float skipFoursBelowProb = 0.0f;
+
+        // Leaf evaluator: a learned n-tuple network, or the built-in heuristic table when null. Switching evaluators
+        // clears the transposition table; retrain a network in place only with reuseTable = false.
+        const NTupleNetwork* evaluator = nullptr;
+
+        // Star1 pruning (Ballard's *-minimax for chance nodes): the heuristic is bounded (LookupTable::heuristicRowMax),
+        // so a chance node stops once even best-case values for its remaining spawns could not lift it to the best
+        // sibling move. Values within a small margin of that move are still searched in full; only nodes are saved.
+        // The table answers only the depth it is probed at (TranspositionTable::get), so every exact value is the one
+        // the plain search computes and decisions are the same (star_pruning_bench: 9075 of 9075 positions at depths
+        // 3 and 4). Only the probability cutoff can tell the searches apart: a transposition below it keeps the value
+        // of the path that stored it first, and pruning may skip that path. Ignored with threads > 1 (parallel root
+        // moves have no bar) and with an evaluator, whose values have no bound.
+        bool starPruning = false;
+
+        // Precomputed moves probed before searching: a hit is returned in microseconds, a miss searches as usual.
+        const OpeningBook* book = nullptr;
+    };
+
     class AISolver {
     public:
         /**
          * @brief Finds the best move for the current board state using Expectimax.
          * @param board The current board state.
          * @param depth Search depth (default 4 is reasonably strong).
+         * @param options Thread count and time budget.
          * @return The best direction to move.
          */
-        static Direction findBestMove(const Board& board, int depth = 4); 
+        static Direction findBestMove(const Board& board, int depth = 4, const SearchOptions& options = {});
+
+        /**
+         * @brief findBestMove() under explicit limits; options.timeLimitMs is ignored (use limits.deadline).
+         * @param stats Filled with what the search did when not null.
+         * @return The best move of the deepest completed iteration (the first legal move if none completed).
+         */
+        static Direction findBestMove(const Board& board, const SearchLimits& limits, const SearchOptions& options = {},
+                                      SearchStats* stats = nullptr);
+
+        /**
+         * @brief Time manager: limits sized to how critical @p board is.
+         *
+         * Open boards (many empty cells) get a shallow search, a coarse probability cutoff and a fraction of
+         * @p budgetMs; crowded boards get a fine cutoff, up to twice the budget and a depth that grows with
+         * the number of distinct tiles (the length of the merge chain to plan for).
+         * @param budgetMs Time for a typical mid-game move (0 = no deadline).
+         */
+        static SearchLimits planSearch(const Board& board, int budgetMs);
+
+        /**
+         * @brief Expectimax for the other board sizes (N = 3..6); SizedBoard<4> takes the Board path.
+         * @param depth Search depth. Larger boards branch much more, so 2-3 is the practical range for 5x5/6x6.
+         * @param options Only timeLimitMs applies for N != 4 (no table, threads or pruning on the sized path).
+         */
+        template <int N>
+        static Direction findBestMove(const SizedBoard<N>& board, int depth = 3, const SearchOptions& options = {});
+
+        /**
+         * @brief Sized findBestMove() under explicit limits (deadline, node budget, depth, probability cutoff).
+         * @return The best move of the deepest completed iteration (the first legal move if none completed).
+         */
+        template <int N>
+        static Direction findBestMove(const SizedBoard<N>& board, const SearchLimits& limits, const SearchOptions& options = {});
 
     private:
+        struct SearchContext;
+
+        // Iterative deepening over the 4x4 bitboard shared by both findBestMove entry points
+        static Direction searchRoot(Bitboard board, const SearchLimits& limits, const SearchOptions& options, SearchStats* stats);
+
         /**
          * @brief Evaluates the current board score using the LookupTable.
          * @param board The bitboard to evaluate.
@@ -23,12 +198,29 @@ namespace tfe::core {
         
         /**
          * @brief Recursively calculates the expectimax score.
+         * @param ctx Options of the running search.
          * @param board Current bitboard state.
          * @param depth Current recursion depth.
          * @param isPlayerTurn True if it's the player's turn (Max node), False for chance node.
          * @param cumulativeProb Cumulative probability of reaching this state (for pruning).
          * @return The expected score.
          */
-        static float expectimax(Bitboard board, int depth, bool isPlayerTurn, float cumulativeProb);
+        static float expectimax(const SearchContext& ctx, Bitboard board, int depth, bool isPlayerTurn, float cumulativeProb);
+
+        /**
+         * @brief expectimax() that forks children onto ctx.pool while @p splitLayers chance layers remain,
+         *        then continues sequentially. Sums are taken in the sequential order, but the shared transposition
+         *        table is filled in a timing-dependent order, so a hit can return another depth's value and results
+         *        may differ slightly from a single-threaded search.
+         */
+        static float expectimaxParallel(const SearchContext& ctx, Bitboard board, int depth, bool isPlayerTurn, float cumulativeProb, int splitLayers);
+
+        /**
+         * @brief expectimax() with Star1 pruning against @p alpha (SearchOptions::starPruning).
+         * @param exact Set to false when the node was cut: the result is then only an upper bound, below @p alpha,
+         *        and goes to the transposition table as one (putUpperBound).
+         */
+        static float expectimaxStar(const SearchContext& ctx, Bitboard board, int depth, bool isPlayerTurn, float cumulativeProb, float alpha,
+                                    bool& exact);
     };
 }
\ No newline at end of file
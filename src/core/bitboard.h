@@ -0,0 +1,146 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+
+#if defined(__BMI2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "types.h"
+
+namespace tfe::core {
+
+    // Rotate 4x4 bitboard (Transpose): row r, col c <-> row c, col r
+    inline Bitboard transpose64(const Bitboard x) {
+        const Bitboard a1 = x & 0xF0F00F0FF0F00F0FULL;
+        const Bitboard a2 = x & 0x0000F0F00000F0F0ULL;
+        const Bitboard a3 = x & 0x0F0F00000F0F0000ULL;
+        const Bitboard a = a1 | (a2 << 12) | (a3 >> 12);
+        const Bitboard b1 = a & 0xFF00FF0000FF00FFULL;
+        const Bitboard b2 = a & 0x00FF00FF00000000ULL;
+        const Bitboard b3 = a & 0x00000000FF00FF00ULL;
+        return b1 | (b2 >> 24) | (b3 << 24);
+    }
+
+#if defined(__AVX2__)
+    // transpose64 applied to each 64-bit lane
+    inline __m256i transpose4x64(const __m256i x) {
+        const __m256i a1 = _mm256_and_si256(x, _mm256_set1_epi64x(static_cast<long long>(0xF0F00F0FF0F00F0FULL)));
+        const __m256i a2 = _mm256_and_si256(x, _mm256_set1_epi64x(0x0000F0F00000F0F0LL));
+        const __m256i a3 = _mm256_and_si256(x, _mm256_set1_epi64x(0x0F0F00000F0F0000LL));
+        const __m256i a = _mm256_or_si256(a1, _mm256_or_si256(_mm256_slli_epi64(a2, 12), _mm256_srli_epi64(a3, 12)));
+        const __m256i b1 = _mm256_and_si256(a, _mm256_set1_epi64x(static_cast<long long>(0xFF00FF0000FF00FFULL)));
+        const __m256i b2 = _mm256_and_si256(a, _mm256_set1_epi64x(0x00FF00FF00000000LL));
+        const __m256i b3 = _mm256_and_si256(a, _mm256_set1_epi64x(0x00000000FF00FF00LL));
+        return _mm256_or_si256(b1, _mm256_or_si256(_mm256_srli_epi64(b2, 24), _mm256_slli_epi64(b3, 24)));
+    }
+#endif
+
+    // Mirror left-right: reverses the 4 tiles of every row (SWAR nibble swap, then byte swap within each row)
+    inline Bitboard flipHorizontal(Bitboard x) {
+        x = ((x & 0x0F0F0F0F0F0F0F0FULL) << 4) | ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL);
+        return ((x & 0x00FF00FF00FF00FFULL) << 8) | ((x >> 8) & 0x00FF00FF00FF00FFULL);
+    }
+
+    // Mirror top-bottom: reverses the order of the 4 rows
+    inline Bitboard flipVertical(Bitboard x) {
+        x = ((x & 0x0000FFFF0000FFFFULL) << 16) | ((x >> 16) & 0x0000FFFF0000FFFFULL);
+        return (x << 32) | (x >> 32);
+    }
+
+    // The 8 rotations/reflections of a board; out[0] is the board itself. out[s] applies the same
+    // transform to every board, so moves commute with it: out[s] of an afterstate is an afterstate of out[s].
+    inline void symmetries(const Bitboard board, Bitboard out[8]) {
+        const Bitboard t = transpose64(board);
+        out[0] = board;
+        out[1] = flipHorizontal(board);
+        out[2] = flipVertical(board);
+        out[3] = flipVertical(out[1]);
+        out[4] = t;
+        out[5] = flipHorizontal(t);
+        out[6] = flipVertical(t);
+        out[7] = flipVertical(out[5]);
+    }
+
+    /**
+     * @brief Smallest of the 8 rotations/reflections of a board (the dihedral group of the square).
+     *
+     * Symmetric boards have the same expectimax value under a symmetric evaluation, so keying the
+     * transposition table on this representative lets all 8 share one entry.
+     */
+    inline Bitboard canonicalBoard(const Bitboard board) {
+        const Bitboard h = flipHorizontal(board);
+        const Bitboard t = transpose64(board);
+        const Bitboard th = flipHorizontal(t);
+        const Bitboard a = std::min(std::min(board, h), std::min(flipVertical(board), flipVertical(h)));
+        const Bitboard b = std::min(std::min(t, th), std::min(flipVertical(t), flipVertical(th)));
+        return std::min(a, b);
+    }
+
+    // Reverses the order of the 4 tiles in a row
+    inline Row reverseRow(const Row row) { return static_cast<Row>((row >> 12) | ((row >> 4) & 0x00F0) | ((row << 4) & 0x0F00) | (row << 12)); }
+
+    // Gathers column c into a 16-bit row-shaped value (cell of row r at bits 4r..4r+3)
+    inline Row extractColumn(const Bitboard board, const int c) {
+        const Bitboard x = (board >> (c * 4)) & 0x000F000F000F000FULL;
+        return static_cast<Row>(x | (x >> 12) | (x >> 24) | (x >> 36));
+    }
+
+    // Inverse of extractColumn for column 0: spreads a 16-bit column back into board positions
+    inline Bitboard unpackColumn(const Row col) {
+        const Bitboard x = col;
+        return (x & 0xF) | ((x & 0xF0) << 12) | ((x & 0xF00) << 24) | ((x & 0xF000) << 36);
+    }
+
+    // Empty-cell mask: bit 4i is set when cell i is empty (branch-free SWAR OR-reduction of each nibble).
+    // Like legalMoves below it reads no table, so it is usable before LookupTable::ensureInitialized().
+    inline uint64_t emptyMask(const Bitboard board) {
+        Bitboard x = board | (board >> 1);
+        x |= x >> 2;
+        return ~x & 0x1111111111111111ULL;
+    }
+
+    inline int countEmpty(const Bitboard board) { return std::popcount(emptyMask(board)); }
+
+    /**
+     * @brief Bit offset (4 * cell index) of the k-th set cell in an emptyMask, 0 <= k < popcount(mask).
+     *
+     * BMI2 deposits bit k straight onto the k-th set bit (pdep) and tzcnt reads its position;
+     * without BMI2 the k lowest bits are cleared one by one.
+     */
+    inline int selectEmptyCell(uint64_t mask, const int k) {
+#if defined(__BMI2__)
+        return std::countr_zero(_pdep_u64(uint64_t{1} << k, mask));
+#else
+        for (int i = 0; i < k; ++i) mask &= mask - 1;
+        return std::countr_zero(mask);
+#endif
+    }
+
+    /**
+     * @brief Legal-move mask without table lookups: bit d is set when Direction d changes the board.
+     *
+     * A direction is legal when some tile has an empty neighbour on the side it moves towards, or
+     * two equal neighbouring tiles can merge. Both tests are SWAR over the per-cell flags of
+     * emptyMask, so the whole board is checked with a handful of shifts and ANDs and no branches.
+     */
+    inline uint8_t legalMoves(const Bitboard board) {
+        constexpr uint64_t NOT_LAST_COL = 0x0111011101110111ULL;  // cells with a right-hand neighbour
+        constexpr uint64_t NOT_LAST_ROW = 0x0000111111111111ULL;  // cells with a neighbour below
+        const uint64_t empty = emptyMask(board);
+        const uint64_t tile = empty ^ 0x1111111111111111ULL;
+
+        // Equal nonempty neighbours merge in both directions of their axis
+        const uint64_t mergeH = emptyMask(board ^ (board >> 4)) & tile & NOT_LAST_COL;
+        const uint64_t mergeV = emptyMask(board ^ (board >> 16)) & tile & NOT_LAST_ROW;
+
+        const uint64_t left = (empty & (tile >> 4) & NOT_LAST_COL) | mergeH;
+        const uint64_t right = ((empty >> 4) & tile & NOT_LAST_COL) | mergeH;
+        const uint64_t up = (empty & (tile >> 16) & NOT_LAST_ROW) | mergeV;
+        const uint64_t down = ((empty >> 16) & tile & NOT_LAST_ROW) | mergeV;
+
+        return static_cast<uint8_t>((up != 0) << static_cast<int>(Direction::Up) | (down != 0) << static_cast<int>(Direction::Down) |
+                                    (left != 0) << static_cast<int>(Direction::Left) | (right != 0) << static_cast<int>(Direction::Right));
+    }
+
+}  // namespace tfe::core
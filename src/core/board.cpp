@@ -1,55 +1,40 @@
 #include "board.h"
 
 #include <algorithm>
+#include <bit>
+#include <stdexcept>
 
+#include "bitboard.h"
 #include "config.h"
 #include "lookup_table.h"
+#include "move_kernel.h"
 #include "score/score-manager.h"
-#include "utils/random-generator.h"
 
 namespace tfe::core {
 
-    // Rotate 4x4 bitboard (Transpose)
-    static inline Bitboard transpose64(const Bitboard x) {
-        const Bitboard a1 = x & 0xF0F00F0FF0F00F0FULL;
-        const Bitboard a2 = x & 0x0000F0F00000F0F0ULL;
-        const Bitboard a3 = x & 0x0F0F00000F0F0000ULL;
-        const Bitboard a = a1 | (a2 << 12) | (a3 >> 12);
-        const Bitboard b1 = a & 0xFF00FF0000FF00FFULL;
-        const Bitboard b2 = a & 0x00FF00FF00000000ULL;
-        const Bitboard b3 = a & 0x00000000FF00FF00ULL;
-        return b1 | (b2 >> 24) | (b3 << 24);
-    }
-
-    Board::Board(int) {
-        static bool tableInitialized = false;
-        if (!tableInitialized) {
-            LookupTable::init();
-
-            // Attempt to load weight file.
-            // Priority:
-            // 1. Same directory (./tuple_weights.bin)
-            // 2. Parent directory (../tuple_weights.bin - for when running from build/)
-            if (!LookupTable::loadWeights("tuple_weights.bin")) {
-                LookupTable::loadWeights("../tuple_weights.bin");
-            }
+    template <typename EventPolicy>
+    BasicBoard<EventPolicy>::BasicBoard(const int size) : BasicBoard(size, tfe::utils::RandomGenerator::randomSeed()) {}
 
-            tableInitialized = true;
-        }
+    template <typename EventPolicy>
+    BasicBoard<EventPolicy>::BasicBoard(const int size, const uint64_t seed) : rng_(seed) {
+        if (size != 4) throw std::invalid_argument("Board: only 4x4 is supported, use SizedBoard<N> for other sizes");
+        LookupTable::ensureInitialized();
         highScore_ = tfe::score::ScoreManager::load_high_score();
         reset();
     }
 
-    void Board::reset() {
+    template <typename EventPolicy>
+    void BasicBoard<EventPolicy>::reset() {
         board_ = 0;
         score_ = 0;
         hasReachedWinTile_ = false;
-        notifyGameReset();
+        this->notifyGameReset();
         spawnRandomTile();
         spawnRandomTile();
     }
 
-    Grid Board::getGrid() const {
+    template <typename EventPolicy>
+    Grid BasicBoard<EventPolicy>::getGrid() const {
         Grid result(4, std::vector<int>(4));
         for (int r = 0; r < 4; ++r) {
             for (int c = 0; c < 4; ++c) {
@@ -60,18 +45,18 @@ namespace tfe::core {
         return result;
     }
 
-    Tile Board::getTile(const int row, const int col) const { return (board_ >> ((row * 16) + (col * 4))) & 0xF; }
+    template <typename EventPolicy>
+    Tile BasicBoard<EventPolicy>::getTile(const int row, const int col) const { return (board_ >> ((row * 16) + (col * 4))) & 0xF; }
 
-    void Board::setTile(const int row, const int col, const Tile value) {
+    template <typename EventPolicy>
+    void BasicBoard<EventPolicy>::setTile(const int row, const int col, const Tile value) {
         const int shift = (row * 16) + (col * 4);
         board_ &= ~(static_cast<Bitboard>(0xF) << shift);
         board_ |= (static_cast<Bitboard>(value) << shift);
     }
 
-    void Board::transpose() { board_ = transpose64(board_); }
-
     // Helper to calculate move events for animations
-    static void generateMoveEvents(const Row row, const int rIdx, const bool isTransposed, const bool isReverse, const Board& board) {
+    static void generateMoveEvents(const Row row, const int rIdx, const bool isTransposed, const bool isReverse, const ObserverEvents& board) {
         int cells[4];
         // Unpack row
         for (int i = 0; i < 4; ++i) cells[i] = (row >> (i * 4)) & 0xF;
@@ -156,35 +141,24 @@ namespace tfe::core {
         }
     }
 
-    bool Board::move(const Direction dir) {
-        const bool isTransposed = (dir == Direction::Up || dir == Direction::Down);
-        const bool isReverse = (dir == Direction::Right || dir == Direction::Down);
-
-        // Normalize to Left/Right. If Up/Down, rotate the board
-        if (isTransposed) transpose();
-
-        Bitboard newBoard = 0;
+    template <typename EventPolicy>
+    bool BasicBoard<EventPolicy>::move(const Direction dir) {
         int moveScore = 0;
-
-        for (int r = 0; r < 4; ++r) {
-            const Row row = (board_ >> (r * 16)) & Config::ROW_MASK;
-            Row newRow;
-
-            // Table lookup
-            if (dir == Direction::Left || dir == Direction::Up)
-                newRow = LookupTable::moveLeftTable[row];
-            else
-                newRow = LookupTable::moveRightTable[row];
-
-            moveScore += LookupTable::scoreTable[row];
-            newBoard |= (static_cast<Bitboard>(newRow) << (r * 16));
-
-            // Generate Animation Events
-            // We calculate events based on the *difference* between 'row' and 'newRow' logic
-            if (row != newRow || true) {  // Always check to be safe, or optimize
-                // Note: generateMoveEvents re-simulates the move to find *which* tile moved *where*.
-                // This is necessary because the bitboard/lookup table doesn't store "history".
-                generateMoveEvents(row, r, isTransposed, isReverse, *this);
+        const Bitboard newBoard = moveBoard(board_, dir, moveScore);
+
+        // Generate Animation Events (compiled out for headless boards)
+        if constexpr (EventPolicy::kEnabled) {
+            const bool isTransposed = (dir == Direction::Up || dir == Direction::Down);
+            const bool isReverse = (dir == Direction::Right || dir == Direction::Down);
+            for (int i = 0; i < 4; ++i) {
+                const Row line = isTransposed ? extractColumn(board_, i) : static_cast<Row>((board_ >> (i * 16)) & Config::ROW_MASK);
+                const Row newLine = isTransposed ? extractColumn(newBoard, i) : static_cast<Row>((newBoard >> (i * 16)) & Config::ROW_MASK);
+                // An unchanged line has no moving or merging tiles, so only changed lines are simulated.
+                if (line != newLine) {
+                    // Note: generateMoveEvents re-simulates the move to find *which* tile moved *where*.
+                    // This is necessary because the bitboard/lookup table doesn't store "history".
+                    generateMoveEvents(line, i, isTransposed, isReverse, *this);
+                }
             }
         }
 
@@ -193,75 +167,65 @@ namespace tfe::core {
             board_ = newBoard;
             score_ += moveScore;
             if (score_ > highScore_) highScore_ = score_;
-        }
-
-        // Rotate back if needed
-        if (isTransposed) transpose();
-
-        if (changed) {
             spawnRandomTile();
         }
         return changed;
     }
 
-    void Board::spawnRandomTile() {
-        std::vector<int> empty;
-        for (int i = 0; i < 16; ++i) {
-            if (((board_ >> (i * 4)) & 0xF) == 0) empty.push_back(i);
-        }
-        if (!empty.empty()) {
-            const int idx = empty[tfe::utils::RandomGenerator::getInt(0, static_cast<int>(empty.size()) - 1)];
-            const Tile val = tfe::utils::RandomGenerator::getBool(Config::SPAWN_PROBABILITY_2) ? Config::TILE_EXPONENT_LOW : Config::TILE_EXPONENT_HIGH;
+    template <typename EventPolicy>
+    void BasicBoard<EventPolicy>::spawnRandomTile() {
+        // No allocation: pick the k-th set bit of the SWAR empty mask
+        const uint64_t empty = emptyMask(board_);
+        if (empty != 0) {
+            const int shift = selectEmptyCell(empty, rng_.getInt(0, std::popcount(empty) - 1));
+            const Tile val = rng_.getBool(Config::SPAWN_PROBABILITY_2) ? Config::TILE_EXPONENT_LOW : Config::TILE_EXPONENT_HIGH;
 
-            board_ |= (static_cast<Bitboard>(val) << (idx * 4));
+            board_ |= (static_cast<Bitboard>(val) << shift);
 
+            const int idx = shift / 4;
             const int r = idx / 4;
             const int c = idx % 4;
-            notifyTileSpawn(r, c, (1 << val));
+            this->notifyTileSpawn(r, c, (1 << val));
         }
     }
 
-    bool Board::isGameOver() const {
-        // Check horizontal rows
-        for (int r = 0; r < 4; ++r) {
-            const Row row = (board_ >> (r * 16)) & 0xFFFF;
-            if (LookupTable::moveLeftTable[row] != row) return false;
-            if (LookupTable::moveRightTable[row] != row) return false;
-        }
-        // Check vertical columns (rotate then check like horizontal)
-        const Bitboard t = transpose64(board_);
-        for (int r = 0; r < 4; ++r) {
-            const Row row = (t >> (r * 16)) & 0xFFFF;
-            if (LookupTable::moveLeftTable[row] != row) return false;
-            if (LookupTable::moveRightTable[row] != row) return false;
-        }
-        notifyGameOver();
+    template <typename EventPolicy>
+    bool BasicBoard<EventPolicy>::isGameOver() const {
+        if (legalMoves() != 0) return false;
+        this->notifyGameOver();
         return true;
     }
 
-    GameState Board::getState() const { return GameState{board_, score_}; }
+    template <typename EventPolicy>
+    GameState BasicBoard<EventPolicy>::getState() const {
+        return GameState{board_, score_};
+    }
 
-    void Board::loadState(const GameState& state) {
+    template <typename EventPolicy>
+    void BasicBoard<EventPolicy>::loadState(const GameState& state) {
         board_ = state.board;
         score_ = state.score;
-        notifyGameReset();
+        this->notifyGameReset();
     }
 
-    void Board::addObserver(IGameObserver* observer) { observers_.push_back(observer); }
-    void Board::removeObserver(IGameObserver* observer) { std::erase(observers_, observer); }
-    void Board::notifyGameReset() const {
+    void ObserverEvents::addObserver(IGameObserver* observer) { observers_.push_back(observer); }
+    void ObserverEvents::removeObserver(IGameObserver* observer) { std::erase(observers_, observer); }
+    void ObserverEvents::notifyGameReset() const {
         for (auto* o : observers_) o->onGameReset();
     }
-    void Board::notifyGameOver() const {
+    void ObserverEvents::notifyGameOver() const {
         for (auto* o : observers_) o->onGameOver();
     }
-    void Board::notifyTileSpawn(const int r, const int c, const int value) const {
+    void ObserverEvents::notifyTileSpawn(const int r, const int c, const int value) const {
         for (auto* o : observers_) o->onTileSpawn(r, c, value);
     }
-    void Board::notifyTileMove(const int fromR, const int fromC, const int toR, const int toC, const int value) const {
+    void ObserverEvents::notifyTileMove(const int fromR, const int fromC, const int toR, const int toC, const int value) const {
         for (auto* o : observers_) o->onTileMove(fromR, fromC, toR, toC, value);
     }
-    void Board::notifyTileMerge(const int r, const int c, const int newValue) const {
+    void ObserverEvents::notifyTileMerge(const int r, const int c, const int newValue) const {
         for (auto* o : observers_) o->onTileMerge(r, c, newValue);
     }
+
+    template class BasicBoard<NoEvents>;
+    template class BasicBoard<ObserverEvents>;
 }  // namespace tfe::core
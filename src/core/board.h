@@ -1,16 +1,33 @@
 #pragma once
 #include <vector>
 
-#include "game-observer.h"
+#include "bitboard.h"
+#include "board_events.h"
 #include "types.h"
+#include "utils/random-generator.h"
 
 namespace tfe::core {
 
-    class Board {
+    /**
+     * @class BasicBoard
+     * @brief The 4x4 bitboard game. EventPolicy decides at compile time whether moves produce observer events.
+     *
+     * Only size 4 is accepted; other sizes throw std::invalid_argument. SizedBoard<N> is the entry point for 3x3 to 6x6.
+     */
+    template <typename EventPolicy>
+    class BasicBoard : public EventPolicy {
     public:
-        explicit Board(int size = 4);
+        // Seeds the spawn generator from std::random_device
+        explicit BasicBoard(int size = 4);
+
+        // Deterministic spawns: equal seeds and equal moves replay the same game
+        BasicBoard(int size, uint64_t seed);
+
         void reset();
 
+        // Restarts the spawn generator (does not touch the board)
+        void seed(uint64_t seed) { rng_.seed(seed); }
+
         int getSize() const { return 4; }
 
         // Convert Bitboard to Grid vector for GUI rendering
@@ -18,42 +35,43 @@ namespace tfe::core {
 
         // Get exponent value at (row, col)
         Tile getTile(int row, int col) const;
-        
+
         // Set exponent value at (row, col)
-        void setTile(int row, int col, Tile value); 
+        void setTile(int row, int col, Tile value);
 
         bool move(Direction dir);
         void spawnRandomTile();
+
+        // Bit d set when Direction d would change the board (pure, no events)
+        uint8_t legalMoves() const { return tfe::core::legalMoves(board_); }
+
+        // True when no direction is legal; fires onGameOver on observable boards
         bool isGameOver() const;
 
         int getScore() const { return score_; }
         int getHighScore() const { return highScore_; }
         bool hasWon() const { return hasReachedWinTile_; }
 
-        // Observer Pattern
-        void addObserver(IGameObserver* observer);
-        void removeObserver(IGameObserver* observer);
-
         // Save/Load
         GameState getState() const;
         void loadState(const GameState& state);
 
-        // Notifications
-        void notifyGameReset() const;
-        void notifyGameOver() const;
-        void notifyTileSpawn(int r, int c, int value) const;
-        void notifyTileMove(int fromR, int fromC, int toR, int toC, int value) const;
-        void notifyTileMerge(int r, int c, int newValue) const;
-
     private:
         Bitboard board_ = 0;  // The only variable containing board data!
         int score_ = 0;
         int highScore_ = 0;
         bool hasReachedWinTile_ = false;
 
-        std::vector<IGameObserver*> observers_;
-
-        // Helper private
-        void transpose();
+        tfe::utils::RandomGenerator rng_;  // Per-board, so boards can be stepped from different threads
     };
-}  // namespace tfe::core
\ No newline at end of file
+
+    // Headless board used by py2048, the solver, tests and training: no animation bookkeeping at all.
+    using Board = BasicBoard<NoEvents>;
+
+    // Board that reports spawns, moves and merges to IGameObserver (used by the GUI).
+    using ObservableBoard = BasicBoard<ObserverEvents>;
+
+    // Both instantiations are compiled once in board.cpp
+    extern template class BasicBoard<NoEvents>;
+    extern template class BasicBoard<ObserverEvents>;
+}  // namespace tfe::core
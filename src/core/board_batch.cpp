@@ -0,0 +1,165 @@
+#include "board_batch.h"
+
+#include <bit>
+#include <cassert>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "bitboard.h"
+#include "config.h"
+#include "lookup_table.h"
+#include "move_kernel.h"
+
+namespace tfe::core {
+
+    static bool hasMove(const Bitboard board) { return legalMoves(board) != 0; }
+
+    static Bitboard spawnTile(const Bitboard board, tfe::utils::RandomGenerator& rng) {
+        const uint64_t empty = emptyMask(board);
+        if (empty == 0) return board;
+
+        const int shift = selectEmptyCell(empty, rng.getInt(0, std::popcount(empty) - 1));
+        const Tile val = rng.getBool(Config::SPAWN_PROBABILITY_2) ? Config::TILE_EXPONENT_LOW : Config::TILE_EXPONENT_HIGH;
+        return board | (static_cast<Bitboard>(val) << shift);
+    }
+
+#if defined(__AVX2__)
+    // Reverses the 4 nibbles of a 16-bit row held in each 32-bit lane
+    static inline __m256i reverseRows8(const __m256i x) {
+        const __m256i n0 = _mm256_and_si256(_mm256_srli_epi32(x, 12), _mm256_set1_epi32(0x000F));
+        const __m256i n1 = _mm256_and_si256(_mm256_srli_epi32(x, 4), _mm256_set1_epi32(0x00F0));
+        const __m256i n2 = _mm256_and_si256(_mm256_slli_epi32(x, 4), _mm256_set1_epi32(0x0F00));
+        const __m256i n3 = _mm256_and_si256(_mm256_slli_epi32(x, 12), _mm256_set1_epi32(0xF000));
+        return _mm256_or_si256(_mm256_or_si256(n0, n1), _mm256_or_si256(n2, n3));
+    }
+
+    // Looks up moveLeftTable for 8 rows. The table holds 16-bit entries, so we gather the aligned
+    // 32-bit word containing each entry and shift the right half down; this never reads past the table.
+    static inline __m256i gatherMoveLeft8(const __m256i rows) {
+        const auto* words = reinterpret_cast<const int*>(LookupTable::moveLeftTable);
+        const __m256i pairs = _mm256_i32gather_epi32(words, _mm256_srli_epi32(rows, 1), 4);
+        const __m256i shift = _mm256_slli_epi32(_mm256_and_si256(rows, _mm256_set1_epi32(1)), 4);
+        return _mm256_and_si256(_mm256_srlv_epi32(pairs, shift), _mm256_set1_epi32(0xFFFF));
+    }
+
+    // Moves 8 rows (two boards) left, or right where the lane mask is set
+    static inline __m256i moveRows8(const __m256i rows, const __m256i reverseMask, __m256i& scores) {
+        const __m256i src = _mm256_blendv_epi8(rows, reverseRows8(rows), reverseMask);
+#if defined(TFE_PACKED_TABLES)
+        // One gather returns both the moved row and its reward
+        const __m256i entries = _mm256_i32gather_epi32(reinterpret_cast<const int*>(LookupTable::packedMoveTable), src, 4);
+        scores = _mm256_slli_epi32(_mm256_srli_epi32(entries, 16), LookupTable::PACKED_REWARD_SHIFT);
+        const __m256i moved = _mm256_and_si256(entries, _mm256_set1_epi32(0xFFFF));
+#else
+        // Merge score is direction independent, so the unreversed row indexes scoreTable directly
+        scores = _mm256_i32gather_epi32(LookupTable::scoreTable, rows, 4);
+        const __m256i moved = gatherMoveLeft8(src);
+#endif
+        return _mm256_blendv_epi8(moved, reverseRows8(moved), reverseMask);
+    }
+
+    // Moves 4 boards at once. The 4 boards are exactly 16 rows, i.e. one 256-bit register of 16-bit rows.
+    static inline void moveBoards4(const Bitboard* in, const Direction* dirs, Bitboard* out, int* rewards) {
+        const auto isVertical = [&](const int k) { return (dirs[k] == Direction::Up || dirs[k] == Direction::Down) ? -1 : 0; };
+        const auto isReverse = [&](const int k) { return (dirs[k] == Direction::Right || dirs[k] == Direction::Down) ? -1 : 0; };
+
+        const __m256i verticalMask = _mm256_setr_epi64x(isVertical(0), isVertical(1), isVertical(2), isVertical(3));
+        // Lane layout after widening: lo = [board0 rows | board1 rows], hi = [board2 rows | board3 rows]
+        const int r0 = isReverse(0), r1 = isReverse(1), r2 = isReverse(2), r3 = isReverse(3);
+        const __m256i reverseLo = _mm256_setr_epi32(r0, r0, r0, r0, r1, r1, r1, r1);
+        const __m256i reverseHi = _mm256_setr_epi32(r2, r2, r2, r2, r3, r3, r3, r3);
+
+        const __m256i boards = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        const __m256i src = _mm256_blendv_epi8(boards, transpose4x64(boards), verticalMask);
+
+        __m256i scoresLo, scoresHi;
+        const __m256i movedLo = moveRows8(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(src)), reverseLo, scoresLo);
+        const __m256i movedHi = moveRows8(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(src, 1)), reverseHi, scoresHi);
+
+        // packus interleaves per 128-bit lane: [b0, b2, b1, b3] -> restore board order
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(movedLo, movedHi), 0xD8);
+        const __m256i result = _mm256_blendv_epi8(packed, transpose4x64(packed), verticalMask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+
+        // Two horizontal adds reduce 4 row scores per board: lanes 0/1 hold boards 0/2, lanes 4/5 boards 1/3
+        __m256i sums = _mm256_hadd_epi32(scoresLo, scoresHi);
+        sums = _mm256_hadd_epi32(sums, sums);
+        alignas(32) int lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+        rewards[0] = lanes[0];
+        rewards[1] = lanes[4];
+        rewards[2] = lanes[1];
+        rewards[3] = lanes[5];
+    }
+#endif
+
+    BoardBatch::BoardBatch(const std::size_t count, const uint64_t seed)
+        : boards_(count), scores_(count), done_(count), rng_(seed), moved_(count), rewards_(count) {
+        reset();
+    }
+
+    void BoardBatch::reset() {
+        for (std::size_t i = 0; i < size(); ++i) reset(i);
+    }
+
+    void BoardBatch::reset(const std::size_t index) {
+        boards_[index] = spawnTile(spawnTile(0, rng_), rng_);
+        scores_[index] = 0;
+        done_[index] = 0;
+    }
+
+    std::size_t BoardBatch::resetFinished() {
+        std::size_t restarted = 0;
+        for (std::size_t i = 0; i < size(); ++i) {
+            if (done_[i]) {
+                reset(i);
+                restarted++;
+            }
+        }
+        return restarted;
+    }
+
+    void BoardBatch::setBoard(const std::size_t index, const Bitboard board, const int score) {
+        boards_[index] = board;
+        scores_[index] = score;
+        done_[index] = hasMove(board) ? 0 : 1;
+    }
+
+    std::size_t BoardBatch::step(const std::span<const Direction> dirs) {
+        assert(dirs.size() == size());
+        moveBoards(boards_.data(), dirs.data(), moved_.data(), rewards_.data(), size());
+
+        std::size_t changedCount = 0;
+        for (std::size_t i = 0; i < size(); ++i) {
+            if (done_[i] || moved_[i] == boards_[i]) continue;
+            boards_[i] = spawnTile(moved_[i], rng_);
+            scores_[i] += rewards_[i];
+            done_[i] = hasMove(boards_[i]) ? 0 : 1;
+            changedCount++;
+        }
+        return changedCount;
+    }
+
+    void BoardBatch::moveBoards(const Bitboard* in, const Direction* dirs, Bitboard* out, int* rewards, const std::size_t count) {
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= count; i += 4) {
+            moveBoards4(in + i, dirs + i, out + i, rewards + i);
+        }
+#endif
+        for (; i < count; ++i) {
+            out[i] = moveBoard(in[i], dirs[i], rewards[i]);
+        }
+    }
+
+    bool BoardBatch::simdEnabled() {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+}  // namespace tfe::core
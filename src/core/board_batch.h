@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "types.h"
+#include "utils/random-generator.h"
+
+namespace tfe::core {
+
+    /**
+     * @class BoardBatch
+     * @brief Structure-of-arrays engine that steps many headless games in one call.
+     *
+     * Boards, scores and done flags live in contiguous arrays so the move kernel can
+     * process several boards per instruction (AVX2 gathers into the lookup tables when
+     * the build enables it, a scalar loop otherwise). There are no observers and no
+     * animation events: this is meant for self-play and training.
+     */
+    class BoardBatch {
+    public:
+        /**
+         * @brief Creates @p count fresh games, each with two spawned tiles.
+         * @param seed Seed of the batch's spawn generator; equal seeds and directions replay identically.
+         */
+        explicit BoardBatch(std::size_t count, uint64_t seed = tfe::utils::RandomGenerator::randomSeed());
+
+        std::size_t size() const { return boards_.size(); }
+
+        // Resets every game in the batch.
+        void reset();
+
+        // Resets a single game.
+        void reset(std::size_t index);
+
+        /**
+         * @brief Resets every game whose done flag is set.
+         * @return The number of games that were restarted.
+         */
+        std::size_t resetFinished();
+
+        /**
+         * @brief Applies dirs[i] to game i, spawns a tile where the board changed and refreshes the done flags.
+         * @param dirs One direction per game (dirs.size() must equal size()). Finished games are skipped.
+         * @return The number of games whose board changed.
+         */
+        std::size_t step(std::span<const Direction> dirs);
+
+        // Contiguous views of the batch state.
+        std::span<const Bitboard> boards() const { return boards_; }
+        std::span<const int> scores() const { return scores_; }
+        std::span<const uint8_t> done() const { return done_; }
+
+        Bitboard getBoard(const std::size_t index) const { return boards_[index]; }
+        int getScore(const std::size_t index) const { return scores_[index]; }
+        bool isDone(const std::size_t index) const { return done_[index] != 0; }
+
+        // Overwrites one game (e.g. to replay a recorded position).
+        void setBoard(std::size_t index, Bitboard board, int score);
+
+        /**
+         * @brief Moves boards without spawning: out[i] = in[i] moved by dirs[i], rewards[i] = merge score.
+         *
+         * This is the raw kernel used by step(); it is exposed for callers that manage spawns themselves.
+         */
+        static void moveBoards(const Bitboard* in, const Direction* dirs, Bitboard* out, int* rewards, std::size_t count);
+
+        // True when the vectorized (AVX2) kernel was compiled in.
+        static bool simdEnabled();
+
+    private:
+        std::vector<Bitboard> boards_;
+        std::vector<int> scores_;
+        std::vector<uint8_t> done_;
+
+        tfe::utils::RandomGenerator rng_;
+
+        // Scratch buffers reused across step() calls so stepping never allocates.
+        std::vector<Bitboard> moved_;
+        std::vector<int> rewards_;
+    };
+
+}  // namespace tfe::core
@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+
+#include "game-observer.h"
+
+namespace tfe::core {
+
+    /**
+     * @struct NoEvents
+     * @brief Event policy for headless boards (Python bindings, solver, tests, training).
+     *
+     * Every notification is an empty inline function and kEnabled lets BasicBoard skip
+     * the move-event simulation entirely, so a headless move is just the table lookups.
+     */
+    struct NoEvents {
+        static constexpr bool kEnabled = false;
+
+        void notifyGameReset() const {}
+        void notifyGameOver() const {}
+        void notifyTileSpawn(int, int, int) const {}
+        void notifyTileMove(int, int, int, int, int) const {}
+        void notifyTileMerge(int, int, int) const {}
+    };
+
+    /**
+     * @class ObserverEvents
+     * @brief Event policy that forwards board events to registered IGameObserver instances (GUI animations).
+     */
+    class ObserverEvents {
+    public:
+        static constexpr bool kEnabled = true;
+
+        // Observer Pattern
+        void addObserver(IGameObserver* observer);
+        void removeObserver(IGameObserver* observer);
+
+        // Notifications
+        void notifyGameReset() const;
+        void notifyGameOver() const;
+        void notifyTileSpawn(int r, int c, int value) const;
+        void notifyTileMove(int fromR, int fromC, int toR, int toC, int value) const;
+        void notifyTileMerge(int r, int c, int newValue) const;
+
+    private:
+        std::vector<IGameObserver*> observers_;
+    };
+
+}  // namespace tfe::core
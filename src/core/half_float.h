@@ -0,0 +1,58 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace tfe::core {
+
+    /**
+     * @brief IEEE 754 binary16 conversions for the quantized weight tables (F16C instructions when available).
+     */
+    inline float halfToFloat(const uint16_t h) {
+#if defined(__F16C__)
+        return _cvtsh_ss(h);
+#else
+        const uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+        const uint32_t exponent = (h >> 10) & 0x1F;
+        uint32_t mantissa = h & 0x3FF;
+        if (exponent == 0x1F) return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));  // Inf / NaN
+        if (exponent != 0) return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+        if (mantissa == 0) return std::bit_cast<float>(sign);
+        // Subnormal: renormalize
+        int e = 113;
+        while ((mantissa & 0x400) == 0) {
+            mantissa <<= 1;
+            --e;
+        }
+        return std::bit_cast<float>(sign | (static_cast<uint32_t>(e) << 23) | ((mantissa & 0x3FF) << 13));
+#endif
+    }
+
+    // Round to nearest even; overflow saturates to infinity
+    inline uint16_t floatToHalf(const float f) {
+#if defined(__F16C__)
+        return _cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT);
+#else
+        const uint32_t x = std::bit_cast<uint32_t>(f);
+        const uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000);
+        const uint32_t abs = x & 0x7FFFFFFF;
+        if (abs >= 0x7F800000) return static_cast<uint16_t>(sign | 0x7C00 | (abs > 0x7F800000 ? 0x200 : 0));  // Inf / NaN
+        if (abs >= 0x477FF000) return static_cast<uint16_t>(sign | 0x7C00);                                     // Rounds past 65504
+        if (abs < 0x38800000) {  // Subnormal half (or zero)
+            if (abs < 0x33000000) return sign;
+            const uint32_t mantissa = (abs & 0x7FFFFF) | 0x800000;
+            const int shift = 126 - static_cast<int>(abs >> 23);  // 14..24
+            const uint32_t half = mantissa >> shift;
+            const uint32_t rest = mantissa & ((1u << shift) - 1);
+            const uint32_t midpoint = 1u << (shift - 1);
+            return static_cast<uint16_t>(sign | (half + (rest > midpoint || (rest == midpoint && (half & 1)))));
+        }
+        const uint32_t rounded = abs + 0xFFF + ((abs >> 13) & 1) - 0x38000000;  // Rebias 127 -> 15
+        return static_cast<uint16_t>(sign | (rounded >> 13));
+#endif
+    }
+
+}  // namespace tfe::core
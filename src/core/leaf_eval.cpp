@@ -0,0 +1,112 @@
+#include "leaf_eval.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace tfe::core {
+
+#if defined(__AVX2__)
+    // Table indices of line `shift / 16` of 8 boards. Dword lane 2k holds board k of `lo`, lane 2k + 1 board k of `hi`.
+    static inline __m256i lineIndex8(const __m256i lo, const __m256i hi, const __m128i shift) {
+        const __m256i mask = _mm256_set1_epi64x(0xFFFF);
+        const __m256i a = _mm256_and_si256(_mm256_srl_epi64(lo, shift), mask);
+        const __m256i b = _mm256_and_si256(_mm256_srl_epi64(hi, shift), mask);
+        return _mm256_or_si256(a, _mm256_slli_epi64(b, 32));
+    }
+
+    // Heuristic values of one line of 8 boards, in the lane order of lineIndex8
+    static inline __m256 gatherFloat(const __m256i index) { return _mm256_i32gather_ps(LookupTable::heuristicTable, index, 4); }
+
+    // 16-bit entries: gather the dword starting at each entry (the table is padded) and keep its low half
+    static inline __m256i gatherInt16(const __m256i index) {
+        const __m256i raw = _mm256_i32gather_epi32(reinterpret_cast<const int*>(LookupTable::heuristicTableInt16), index, 2);
+        return _mm256_srai_epi32(_mm256_slli_epi32(raw, 16), 16);
+    }
+
+#if defined(__F16C__)
+    static inline __m256 gatherHalf(const __m256i index) {
+        const __m256i raw = _mm256_i32gather_epi32(reinterpret_cast<const int*>(LookupTable::heuristicTableHalf), index, 2);
+        // Pack the 8 low halves into 128 bits (packus works per 128-bit lane), then convert
+        const __m256i packed = _mm256_packus_epi32(_mm256_and_si256(raw, _mm256_set1_epi32(0xFFFF)), _mm256_setzero_si256());
+        return _mm256_cvtph_ps(_mm256_castsi256_si128(_mm256_permute4x64_epi64(packed, 0x08)));
+    }
+#endif
+
+    static inline void storeInterleaved(const __m256 values, float* scores) {
+        alignas(32) float interleaved[8];
+        _mm256_store_ps(interleaved, values);
+        for (int k = 0; k < 4; ++k) {
+            scores[k] = interleaved[2 * k];
+            scores[4 + k] = interleaved[2 * k + 1];
+        }
+    }
+
+    // Same association as the scalar evaluators: ((r0 + r1) + r2) + r3, then + (((c0 + c1) + c2) + c3)
+    template <WeightPrecision P>
+    static inline void evaluate8(const Bitboard* boards, float* scores) {
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boards));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boards + 4));
+        const __m256i tlo = transpose4x64(lo);
+        const __m256i thi = transpose4x64(hi);
+
+        if constexpr (P == WeightPrecision::Int16) {
+            __m256i sum = _mm256_setzero_si256();
+            for (int line = 0; line < 4; ++line) {
+                const __m128i shift = _mm_cvtsi32_si128(16 * line);
+                sum = _mm256_add_epi32(sum, gatherInt16(lineIndex8(lo, hi, shift)));
+                sum = _mm256_add_epi32(sum, gatherInt16(lineIndex8(tlo, thi, shift)));
+            }
+            const __m256 scaled = _mm256_mul_ps(_mm256_set1_ps(LookupTable::heuristicScale), _mm256_cvtepi32_ps(sum));
+            storeInterleaved(_mm256_add_ps(_mm256_set1_ps(8.0f * LookupTable::heuristicBias), scaled), scores);
+        } else {
+            const auto gather = [](const __m256i index) {
+#if defined(__F16C__)
+                if constexpr (P == WeightPrecision::Float16) return gatherHalf(index);
+#endif
+                return gatherFloat(index);
+            };
+            __m256 rows = gather(lineIndex8(lo, hi, _mm_cvtsi32_si128(0)));
+            __m256 cols = gather(lineIndex8(tlo, thi, _mm_cvtsi32_si128(0)));
+            for (int line = 1; line < 4; ++line) {
+                const __m128i shift = _mm_cvtsi32_si128(16 * line);
+                rows = _mm256_add_ps(rows, gather(lineIndex8(lo, hi, shift)));
+                cols = _mm256_add_ps(cols, gather(lineIndex8(tlo, thi, shift)));
+            }
+            __m256 values = _mm256_add_ps(rows, cols);
+            if constexpr (P == WeightPrecision::Float16) {
+                const __m256 scaled = _mm256_mul_ps(_mm256_set1_ps(LookupTable::heuristicScale), values);
+                values = _mm256_add_ps(_mm256_set1_ps(8.0f * LookupTable::heuristicBias), scaled);
+            }
+            storeInterleaved(values, scores);
+        }
+    }
+#endif
+
+    void evaluateLeaves(const Bitboard* boards, float* scores, const std::size_t count) {
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        const WeightPrecision precision = LookupTable::weightPrecision;
+        if (precision == WeightPrecision::Int16) {
+            for (; i + 8 <= count; i += 8) evaluate8<WeightPrecision::Int16>(boards + i, scores + i);
+        } else if (precision == WeightPrecision::Float32) {
+            for (; i + 8 <= count; i += 8) evaluate8<WeightPrecision::Float32>(boards + i, scores + i);
+        }
+#if defined(__F16C__)
+        else {
+            for (; i + 8 <= count; i += 8) evaluate8<WeightPrecision::Float16>(boards + i, scores + i);
+        }
+#endif
+#endif
+        for (; i < count; ++i) scores[i] = evaluateLeaf(boards[i]);
+    }
+
+    bool leafEvalSimdEnabled() {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+}  // namespace tfe::core
@@ -1,42 +1,49 @@
 #include "lookup_table.h"
 #include <algorithm>
 #include <cmath>
-#include <vector>
 #include <fstream>
-#include <iostream> 
-
-namespace tfe::core {
-
-    Row LookupTable::moveLeftTable[65536];
-    Row LookupTable::moveRightTable[65536];
-    int LookupTable::scoreTable[65536];
-    float LookupTable::heuristicTable[65536];
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <vector>
 
-    // Heuristic weights (referenced from nneonneo)
-    // Later we will use RL to refine these numbers
-    static const float SCORE_LOST_PENALTY = 200000.0f;
-    static const float SCORE_MONOTONICITY_POWER = 4.0f;
-    static const float SCORE_MONOTONICITY_WEIGHT = 47.0f;
-    static const float SCORE_SUM_POWER = 3.5f;
-    static const float SCORE_SUM_WEIGHT = 11.0f;
-    static const float SCORE_MERGES_WEIGHT = 700.0f;
-    static const float SCORE_EMPTY_WEIGHT = 270.0f;
+#include "half_float.h"
 
-    static Row reverseRow(Row row) {
-        return (row >> 12) | ((row >> 4) & 0x00F0) | ((row << 4) & 0x0F00) | (row << 12);
-    }
+namespace tfe::core {
 
-    void LookupTable::init() {
-        for (int i = 0; i < 65536; ++i) {
-            initRow(i);
-        }
-        // Second pass for moveRightTable to ensure moveLeftTable is fully populated
-        for (int i = 0; i < 65536; ++i) {
-             moveRightTable[i] = reverseRow(moveLeftTable[reverseRow(i)]);
-        }
+    // The const tables are defined in the generated lookup_table_data.cpp (see lookup_table_gen.cpp).
+
+    // Learned weights replace the default heuristic here; untouched .bss pages cost nothing until loaded.
+    static float loadedHeuristicTable[65536];
+
+    const float* LookupTable::heuristicTable = LookupTable::defaultHeuristicTable;
+
+    WeightPrecision LookupTable::weightPrecision = WeightPrecision::Float32;
+    alignas(64) int16_t LookupTable::heuristicTableInt16[65536 + 2];
+    alignas(64) uint16_t LookupTable::heuristicTableHalf[65536 + 2];
+    float LookupTable::heuristicBias = 0;
+    float LookupTable::heuristicScale = 1;
+    float LookupTable::heuristicRowMin = 0;
+    float LookupTable::heuristicRowMax[16] = {};
+    uint32_t LookupTable::weightsEpoch = 0;
+
+    void LookupTable::ensureInitialized() {
+        // Function-local static: thread-safe, runs once per process
+        static const bool initialized = [] {
+            // Attempt to load weight file.
+            // Priority:
+            // 1. Same directory (./tuple_weights.bin)
+            // 2. Parent directory (../tuple_weights.bin - for when running from build/)
+            // The precision chosen before the first Board (setWeightPrecision) carries over
+            if (!loadWeights("tuple_weights.bin", weightPrecision) && !loadWeights("../tuple_weights.bin", weightPrecision)) {
+                setWeightPrecision(weightPrecision);  // Built-in table: still derive the row bounds
+            }
+            return true;
+        }();
+        (void)initialized;
     }
 
-    bool LookupTable::loadWeights(const char* filepath) {
+    bool LookupTable::loadWeights(const char* filepath, const WeightPrecision precision) {
         std::ifstream file(filepath, std::ios::binary);
         if (!file.is_open()) {
             std::cerr << "[Core] Warning: Could not open weights file: " << filepath << ". Using default heuristics.\n";
@@ -51,82 +58,53 @@ namespace tfe::core {
             return false;
         }
 
+        // Read fully before touching the live table so a truncated file can't corrupt it
+        std::vector<float> weights(count);
+        file.read(reinterpret_cast<char*>(weights.data()), count * sizeof(float));
+        if (!file) {
+            std::cerr << "[Core] Error: Truncated weights file: " << filepath << "\n";
+            return false;
+        }
+
         // Overwrite heuristicTable
-        file.read(reinterpret_cast<char*>(heuristicTable), count * sizeof(float));
-        
+        std::copy(weights.begin(), weights.end(), loadedHeuristicTable);
+        heuristicTable = loadedHeuristicTable;
+        setWeightPrecision(precision);
+
         std::cout << "[Core] Successfully loaded AI weights from " << filepath << "\n";
         return true;
     }
 
-    static std::vector<int> unpack(int row) {
-        std::vector<int> line(4);
-        line[0] = (row >> 0) & 0xF;
-        line[1] = (row >> 4) & 0xF;
-        line[2] = (row >> 8) & 0xF;
-        line[3] = (row >> 12) & 0xF;
-        return line;
-    }
-
-    static Row pack(const std::vector<int>& line) {
-        Row row = 0;
-        row |= (line[0] << 0);
-        row |= (line[1] << 4);
-        row |= (line[2] << 8);
-        row |= (line[3] << 12);
-        return row;
-    }
-
-    void LookupTable::initRow(int row) {
-        auto line = unpack(row);
-
-        // 1. Calculate Heuristic Score (Evaluate goodness of this row)
-        float sum = 0;
-        int empty = 0;
-        int merges = 0;
-        int prev = 0;
-        int counter = 0;
-
-        for (int val : line) {
-            sum += std::pow(val, SCORE_SUM_POWER);
-            if (val == 0) {
-                empty++;
-            } else {
-                if (prev == val) counter++;
-                else if (counter > 0) { merges += 1 + counter; counter = 0; }
-                prev = val;
+    void LookupTable::setWeightPrecision(const WeightPrecision precision) {
+        const auto [lo, hi] = std::minmax_element(heuristicTable, heuristicTable + 65536);
+        if (precision == WeightPrecision::Int16) {
+            // [lo, hi] onto [-32767, 32767]
+            heuristicBias = (*lo + *hi) / 2;
+            heuristicScale = *hi > *lo ? (*hi - *lo) / 65534.0f : 1.0f;
+            for (int i = 0; i < 65536; ++i) {
+                const float q = std::round((heuristicTable[i] - heuristicBias) / heuristicScale);
+                heuristicTableInt16[i] = static_cast<int16_t>(std::clamp(q, -32767.0f, 32767.0f));
             }
+        } else if (precision == WeightPrecision::Float16) {
+            // Relative precision is what fp16 keeps, so no bias; the scale only keeps |value| below 65504
+            heuristicBias = 0;
+            const float maxAbs = std::max(std::fabs(*lo), std::fabs(*hi));
+            heuristicScale = maxAbs > 32768.0f ? maxAbs / 32768.0f : 1.0f;
+            for (int i = 0; i < 65536; ++i) heuristicTableHalf[i] = floatToHalf(heuristicTable[i] / heuristicScale);
         }
-        if (counter > 0) merges += 1 + counter;
-
-        float mono_left = 0, mono_right = 0;
-        for (int i = 1; i < 4; ++i) {
-            if (line[i-1] > line[i]) mono_left += std::pow(line[i-1], SCORE_MONOTONICITY_POWER) - std::pow(line[i], SCORE_MONOTONICITY_POWER);
-            else mono_right += std::pow(line[i], SCORE_MONOTONICITY_POWER) - std::pow(line[i-1], SCORE_MONOTONICITY_POWER);
-        }
-
-        heuristicTable[row] = SCORE_LOST_PENALTY +
-            SCORE_EMPTY_WEIGHT * empty +
-            SCORE_MERGES_WEIGHT * merges -
-            SCORE_MONOTONICITY_WEIGHT * std::min(mono_left, mono_right) -
-            SCORE_SUM_WEIGHT * sum;
-
-        // 2. Calculate Move Left Logic
-        int score = 0;
-        std::vector<int> temp;
-        for (int val : line) if (val != 0) temp.push_back(val); // Compress
-        
-        if (!temp.empty()) {
-            for (size_t i = 0; i < temp.size() - 1; ++i) {
-                if (temp[i] == temp[i+1]) { // Merge
-                    temp[i]++; 
-                    score += (1 << temp[i]); // Add actual score (2^k)
-                    temp.erase(temp.begin() + i + 1);
-                }
-            }
+        weightPrecision = precision;
+        ++weightsEpoch;
+
+        // Row bounds of the values evaluateLeaf now reads, per biggest tile
+        heuristicRowMin = std::numeric_limits<float>::max();
+        std::fill(std::begin(heuristicRowMax), std::end(heuristicRowMax), std::numeric_limits<float>::lowest());
+        for (int row = 0; row < 65536; ++row) {
+            float value = heuristicTable[row];
+            if (precision == WeightPrecision::Int16) value = heuristicBias + heuristicScale * static_cast<float>(heuristicTableInt16[row]);
+            else if (precision == WeightPrecision::Float16) value = heuristicBias + heuristicScale * halfToFloat(heuristicTableHalf[row]);
+            const int top = std::max(std::max(row & 0xF, (row >> 4) & 0xF), std::max((row >> 8) & 0xF, row >> 12));
+            heuristicRowMin = std::min(heuristicRowMin, value);
+            heuristicRowMax[top] = std::max(heuristicRowMax[top], value);
         }
-        while (temp.size() < 4) temp.push_back(0); // Fill with 0
-
-        moveLeftTable[row] = pack(temp);
-        scoreTable[row] = score;
     }
-}
\ No newline at end of file
+}
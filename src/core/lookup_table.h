@@ -3,31 +3,91 @@
 
 namespace tfe::core {
 
+    // Encoding of the heuristic table the leaf evaluator reads (see LookupTable::setWeightPrecision)
+    enum class WeightPrecision : uint8_t {
+        Float32,  // heuristicTable itself: 256 KB
+        Int16,    // heuristicBias + heuristicScale * int16, summed in int32: 128 KB
+        Float16,  // heuristicBias + heuristicScale * fp16, summed in float: 128 KB
+    };
+
+    /**
+     * @class LookupTable
+     * @brief Precomputed per-row tables for moves, scores and heuristics.
+     *
+     * The move, score and default heuristic tables are generated at build time (lookup-table-gen)
+     * into const data, so they are ready before main() runs, live in read-only pages shared across
+     * processes, and need no initialization (and therefore no synchronization) at all. The active
+     * heuristic is not: the quantized copies and heuristicRowMin/Max are only filled in by
+     * ensureInitialized(), loadWeights() or setWeightPrecision(), which evaluateLeaf and the search
+     * bounds rely on.
+     */
     class LookupTable {
     public:
         /**
-         * @brief Initializes the lookup tables.
+         * @brief Loads the default weight file (./tuple_weights.bin or ../tuple_weights.bin) exactly once per process.
          */
-        static void init();
-        
+        static void ensureInitialized();
+
         /**
          * @brief Loads weights from a binary file.
          * @param filepath Path to the binary file containing weights.
+         * @param precision Encoding the evaluator reads them in (see setWeightPrecision).
          * @return True if loading was successful, false otherwise.
          */
-        static bool loadWeights(const char* filepath);
+        static bool loadWeights(const char* filepath, WeightPrecision precision = WeightPrecision::Float32);
+
+        /**
+         * @brief Re-encodes the active heuristicTable (built-in or loaded) for the leaf evaluator.
+         *
+         * The quantized tables are half the size of the float one, so more of them stays in L1/L2 during deep
+         * searches. Int16 maps the table's range linearly onto 65535 steps; Float16 keeps ~3 significant digits.
+         * Like loadWeights, this must not run concurrently with a search.
+         */
+        static void setWeightPrecision(WeightPrecision precision);
 
         // Input: Current row (16 bits). Output: New row after moving (16 bits).
-        static Row moveLeftTable[65536];
-        static Row moveRightTable[65536];
+        static const Row moveLeftTable[65536];
+        static const Row moveRightTable[65536];
+
+        // Input: Column (16 bits, row r at bits 4r). Output: moved column already spread into
+        // column-0 board positions, so a vertical move is 4 lookups shifted by 4*c and ORed together.
+        static const Bitboard moveUpCol[65536];
+        static const Bitboard moveDownCol[65536];
 
         // Score received when performing a move on that row
-        static int scoreTable[65536];
+        static const int scoreTable[65536];
+
+        // Packed layout (TFE_PACKED_TABLES): one 4-byte entry per row holding the moved-left row in the
+        // low 16 bits and score / 4 in the high 16 bits. Right moves use reverseRow on both sides and
+        // columns reuse the same entries, so the whole move path touches 256 KB instead of ~1.5 MB.
+        static const uint32_t packedMoveTable[65536];
+        static constexpr int PACKED_REWARD_SHIFT = 2;
+
+        // Built-in heuristic score of each row (nneonneo weights)
+        static const float defaultHeuristicTable[65536];
+
+        // Heuristic score of that row (used for AI to evaluate board state).
+        // Points at defaultHeuristicTable until loadWeights() succeeds.
+        static const float* heuristicTable;
+
+        // Encoding evaluateLeaf reads; heuristicTable stays the float reference whatever the precision.
+        static WeightPrecision weightPrecision;
+
+        // Quantized copies of heuristicTable: row value = heuristicBias + heuristicScale * entry. One entry of
+        // padding keeps 4-byte gathers at the last index in bounds.
+        static int16_t heuristicTableInt16[65536 + 2];
+        static uint16_t heuristicTableHalf[65536 + 2];
+        static float heuristicBias;
+        static float heuristicScale;
 
-        // Heuristic score of that row (used for AI to evaluate board state)
-        static float heuristicTable[65536];
+        // Range of the value one row adds to evaluateLeaf, in the active encoding: heuristicRowMax[t] is the largest
+        // over rows whose biggest tile has exponent t (the empty row counts as t = 0). Set by setWeightPrecision (and
+        // thus by loadWeights and ensureInitialized); expectimax pruning derives its bounds from them.
+        static float heuristicRowMin;
+        static float heuristicRowMax[16];
 
-    private:
-        static void initRow(int row);
+        // Bumped by every setWeightPrecision (and thus loadWeights): a search seeing a new value drops table
+        // entries scored under the old weights.
+        static uint32_t weightsEpoch;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,138 @@
+// Build-time generator for the 2048 lookup tables.
+//
+// Usage: lookup-table-gen <output.cpp>
+//
+// Writes a translation unit that defines every LookupTable array as initialized const data,
+// so the tables live in read-only pages shared between processes and cost nothing at startup.
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "bitboard.h"
+#include "row_heuristic.h"
+#include "types.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    Row moveLeftTable[65536];
+    Row moveRightTable[65536];
+    Bitboard moveUpCol[65536];
+    Bitboard moveDownCol[65536];
+    int scoreTable[65536];
+    float heuristicTable[65536];
+    uint32_t packedMoveTable[65536];
+
+    std::vector<int> unpack(int row) {
+        std::vector<int> line(4);
+        line[0] = (row >> 0) & 0xF;
+        line[1] = (row >> 4) & 0xF;
+        line[2] = (row >> 8) & 0xF;
+        line[3] = (row >> 12) & 0xF;
+        return line;
+    }
+
+    Row pack(const std::vector<int>& line) {
+        Row row = 0;
+        row |= (line[0] << 0);
+        row |= (line[1] << 4);
+        row |= (line[2] << 8);
+        row |= (line[3] << 12);
+        return row;
+    }
+
+    void initRow(int row) {
+        auto line = unpack(row);
+
+        // 1. Calculate Heuristic Score (Evaluate goodness of this row)
+        heuristicTable[row] = lineHeuristic(line.data(), 4);
+
+        // 2. Calculate Move Left Logic
+        int score = 0;
+        std::vector<int> temp;
+        for (int val : line) if (val != 0) temp.push_back(val); // Compress
+
+        if (!temp.empty()) {
+            for (size_t i = 0; i < temp.size() - 1; ++i) {
+                if (temp[i] == temp[i+1]) { // Merge
+                    temp[i]++;
+                    score += (1 << temp[i]); // Add actual score (2^k)
+                    temp.erase(temp.begin() + i + 1);
+                }
+            }
+        }
+        while (temp.size() < 4) temp.push_back(0); // Fill with 0
+
+        moveLeftTable[row] = pack(temp);
+        scoreTable[row] = score;
+    }
+
+    void build() {
+        for (int i = 0; i < 65536; ++i) {
+            initRow(i);
+        }
+        // Second pass for moveRightTable to ensure moveLeftTable is fully populated
+        for (int i = 0; i < 65536; ++i) {
+            moveRightTable[i] = reverseRow(moveLeftTable[reverseRow(i)]);
+        }
+        // A column read top-to-bottom is a row: Up is a left move, Down a right move
+        for (int i = 0; i < 65536; ++i) {
+            moveUpCol[i] = unpackColumn(moveLeftTable[i]);
+            moveDownCol[i] = unpackColumn(moveRightTable[i]);
+        }
+        // Every merge score is a multiple of 4 (smallest merge is 2+2), so score/4 fits 16 bits
+        for (int i = 0; i < 65536; ++i) {
+            packedMoveTable[i] = moveLeftTable[i] | (static_cast<uint32_t>(scoreTable[i] >> 2) << 16);
+        }
+    }
+
+    // Writes "<decl> = { ... };" with 16 values per line
+    template <typename T, typename Fmt>
+    void writeArray(FILE* out, const char* decl, const T* values, Fmt&& format) {
+        std::fprintf(out, "    %s[65536] = {\n", decl);
+        for (int i = 0; i < 65536; ++i) {
+            if (i % 16 == 0) std::fputs("        ", out);
+            format(out, values[i]);
+            std::fputs(i % 16 == 15 ? ",\n" : ", ", out);
+        }
+        std::fputs("    };\n\n", out);
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <output.cpp>\n", argv[0]);
+        return 1;
+    }
+
+    build();
+
+    FILE* out = std::fopen(argv[1], "w");
+    if (!out) {
+        std::fprintf(stderr, "lookup-table-gen: cannot write %s\n", argv[1]);
+        return 1;
+    }
+
+    std::fputs("// Generated by lookup-table-gen at build time. Do not edit.\n", out);
+    std::fputs("#include \"core/lookup_table.h\"\n\nnamespace tfe::core {\n\n", out);
+
+    const auto hex16 = [](FILE* f, const Row v) { std::fprintf(f, "0x%04X", v); };
+    const auto hex32 = [](FILE* f, const uint32_t v) { std::fprintf(f, "0x%08XU", v); };
+    const auto hex64 = [](FILE* f, const Bitboard v) { std::fprintf(f, "0x%016llXULL", static_cast<unsigned long long>(v)); };
+    const auto dec = [](FILE* f, const int v) { std::fprintf(f, "%d", v); };
+    // Hex-float literals round-trip exactly
+    const auto flt = [](FILE* f, const float v) { std::fprintf(f, "%af", static_cast<double>(v)); };
+
+    writeArray(out, "alignas(64) const Row LookupTable::moveLeftTable", moveLeftTable, hex16);
+    writeArray(out, "alignas(64) const Row LookupTable::moveRightTable", moveRightTable, hex16);
+    writeArray(out, "alignas(64) const Bitboard LookupTable::moveUpCol", moveUpCol, hex64);
+    writeArray(out, "alignas(64) const Bitboard LookupTable::moveDownCol", moveDownCol, hex64);
+    writeArray(out, "alignas(64) const int LookupTable::scoreTable", scoreTable, dec);
+    writeArray(out, "alignas(64) const uint32_t LookupTable::packedMoveTable", packedMoveTable, hex32);
+    writeArray(out, "alignas(64) const float LookupTable::defaultHeuristicTable", heuristicTable, flt);
+
+    std::fputs("}  // namespace tfe::core\n", out);
+    return std::fclose(out) == 0 ? 0 : 1;
+}
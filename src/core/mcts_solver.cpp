@@ -0,0 +1,316 @@
+#include "mcts_solver.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "bitboard.h"
+#include "move_kernel.h"
+#include "utils/random-generator.h"
+#include "utils/thread-pool.h"
+
+namespace tfe::core {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+
+        // Playouts between two looks at the clock
+        constexpr uint64_t CLOCK_CHECK_INTERVAL = 16;
+
+        // Index 0 is the root, which nothing points at, so 0 doubles as "none"
+        constexpr uint32_t NONE = 0;
+
+        /**
+         * Decision node: board with the player to move; children are 4 consecutive chance nodes (one per direction).
+         * Chance node: afterstate of one move; children are decision nodes linked through `sibling`.
+         */
+        struct Node {
+            Bitboard board = 0;
+            double valueSum = 0;  // Score collected from this node on, summed over the playouts through it
+            uint32_t visits = 0;
+            uint32_t firstChild = NONE;
+            uint32_t sibling = NONE;
+            int32_t reward = 0;  // Chance node: merge reward of the move
+            uint8_t legal = 0;   // Decision node: legal moves
+        };
+
+        // Bump allocator over a vector that grows with the tree, up to the limit set by reset()
+        class NodeArena {
+        public:
+            void reset(const std::size_t limit) {
+                nodes_.reserve(limit);  // Address space only: pages are touched as the tree grows
+                limit_ = limit;
+                used_ = 0;
+            }
+
+            // Index of @p count fresh consecutive nodes, NONE when the arena is full (never for the root)
+            uint32_t allocate(const uint32_t count) {
+                if (used_ + count > limit_) return NONE;
+                if (used_ + count > nodes_.size()) nodes_.resize(std::min(limit_, std::max(used_ + count, 2 * nodes_.size())));
+                const auto index = static_cast<uint32_t>(used_);
+                for (uint32_t i = 0; i < count; ++i) nodes_[used_ + i] = Node{};
+                used_ += count;
+                return index;
+            }
+
+            // Gives the memory back when it holds more than @p keep nodes
+            void trim(const std::size_t keep) {
+                if (nodes_.size() <= keep) return;
+                nodes_.clear();
+                nodes_.shrink_to_fit();
+            }
+
+            Node& operator[](const uint32_t index) { return nodes_[index]; }
+            std::size_t used() const { return used_; }
+
+        private:
+            std::vector<Node> nodes_;
+            std::size_t used_ = 0;
+            std::size_t limit_ = 0;
+        };
+
+        Bitboard spawnTile(const Bitboard board, tfe::utils::RandomGenerator& rng) {
+            const uint64_t empty = emptyMask(board);
+            const int shift = selectEmptyCell(empty, rng.getInt(0, std::popcount(empty) - 1));
+            return board | (static_cast<Bitboard>(rng.getBool(0.1) ? 2 : 1) << shift);
+        }
+
+        // Random legal moves from @p board; returns the score they collect
+        double rollout(Bitboard board, tfe::utils::RandomGenerator& rng, const int maxMoves) {
+            double score = 0;
+            for (int moves = 0; maxMoves == 0 || moves < maxMoves; ++moves) {
+                const MoveSet set = computeMoves(board);
+                if (set.legal == 0) break;
+                const int dir = selectEmptyCell(set.legal, rng.getInt(0, std::popcount(set.legal) - 1));
+                score += set.reward[dir];
+                board = spawnTile(set.after[dir], rng);
+            }
+            return score;
+        }
+
+        struct TreeSearch {
+            NodeArena& arena;
+            tfe::utils::RandomGenerator rng;
+            const MCTSOptions& options;
+            std::vector<uint32_t> path;  // Nodes of the running playout, root first
+
+            // UCB1 over the legal chance children of decision node @p parent. Means are rescaled to [0, 1] between
+            // the worst and best sibling: raw scores differ by a few percent, which no fixed constant could weigh.
+            uint32_t select(const uint32_t parent) {
+                const Node& node = arena[parent];
+                double lo = std::numeric_limits<double>::max(), hi = 0;
+                for (uint8_t legal = node.legal; legal != 0; legal &= legal - 1) {
+                    const Node& child = arena[node.firstChild + std::countr_zero(legal)];
+                    if (child.visits == 0) return node.firstChild + std::countr_zero(legal);  // Try every move once
+                    const double mean = child.valueSum / child.visits;
+                    lo = std::min(lo, mean);
+                    hi = std::max(hi, mean);
+                }
+                const double norm = hi > lo ? 1.0 / (hi - lo) : 0.0;
+                const double logVisits = std::log(static_cast<double>(node.visits));
+                uint32_t best = NONE;
+                double bestScore = -1;
+                for (uint8_t legal = node.legal; legal != 0; legal &= legal - 1) {
+                    const uint32_t index = node.firstChild + std::countr_zero(legal);
+                    const Node& child = arena[index];
+                    const double score = (child.valueSum / child.visits - lo) * norm + options.exploration * std::sqrt(logVisits / child.visits);
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best = index;
+                    }
+                }
+                return best;
+            }
+
+            // Decision child of chance node @p parent for @p board, added to the tree when missing (NONE if full)
+            uint32_t childFor(const uint32_t parent, const Bitboard board, bool& added) {
+                added = false;
+                for (uint32_t index = arena[parent].firstChild; index != NONE; index = arena[index].sibling) {
+                    if (arena[index].board == board) return index;
+                }
+                const uint32_t index = arena.allocate(1);
+                if (index == NONE) return NONE;
+                arena[index].board = board;
+                arena[index].legal = legalMoves(board);
+                arena[index].sibling = arena[parent].firstChild;
+                arena[parent].firstChild = index;
+                added = true;
+                return index;
+            }
+
+            // Expands decision node @p index into its chance children; false when the arena is full
+            bool expand(const uint32_t index) {
+                const uint32_t first = arena.allocate(4);
+                if (first == NONE) return false;
+                const MoveSet moves = computeMoves(arena[index].board);
+                for (int dir = 0; dir < 4; ++dir) {
+                    arena[first + dir].board = moves.after[dir];
+                    arena[first + dir].reward = moves.reward[dir];
+                }
+                arena[index].firstChild = first;
+                return true;
+            }
+
+            void playout() {
+                path.clear();
+                uint32_t node = 0;
+                path.push_back(node);
+                double value = 0;
+                while (true) {
+                    if (arena[node].legal == 0) break;  // Game over: nothing more to collect
+                    if (arena[node].firstChild == NONE && !expand(node)) {
+                        value = rollout(arena[node].board, rng, options.maxRolloutMoves);
+                        break;
+                    }
+                    const uint32_t chance = select(node);
+                    path.push_back(chance);
+
+                    bool added = false;
+                    const Bitboard next = spawnTile(arena[chance].board, rng);
+                    const uint32_t child = childFor(chance, next, added);
+                    if (child == NONE || added) {  // New leaf (or no room for one): estimate it by a rollout
+                        if (child != NONE) path.push_back(child);
+                        value = rollout(next, rng, options.maxRolloutMoves);
+                        break;
+                    }
+                    node = child;
+                    path.push_back(node);
+                }
+
+                // Back up: every node gets the score collected from it on
+                for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                    Node& n = arena[*it];
+                    value += n.reward;
+                    n.valueSum += value;
+                    ++n.visits;
+                }
+            }
+        };
+
+        // Arenas outlive searches so their memory is reused; each call leases one per tree, so concurrent
+        // searches (e.g. games played side by side) never share one. Only small trees keep their memory in the
+        // pool: a bigger one is freed on release, so a long-running process holds at most this much per arena.
+        constexpr std::size_t RETAINED_NODES = std::size_t{1} << 16;  // 2.5 MB
+
+        class ArenaPool {
+        public:
+            std::unique_ptr<NodeArena> acquire() {
+                const std::lock_guard lock(mutex_);
+                if (free_.empty()) return std::make_unique<NodeArena>();
+                std::unique_ptr<NodeArena> arena = std::move(free_.back());
+                free_.pop_back();
+                return arena;
+            }
+
+            void release(std::unique_ptr<NodeArena> arena) {
+                arena->trim(RETAINED_NODES);
+                const std::lock_guard lock(mutex_);
+                free_.push_back(std::move(arena));
+            }
+
+        private:
+            std::mutex mutex_;
+            std::vector<std::unique_ptr<NodeArena>> free_;
+        };
+
+        ArenaPool& arenaPool() {
+            static ArenaPool pool;
+            return pool;
+        }
+
+    }  // namespace
+
+    Direction MCTSSolver::findBestMove(const Board& board, const MCTSOptions& options, MCTSStats* stats) {
+        const auto start = Clock::now();
+        const Bitboard root = board.getState().board;
+        const uint8_t rootLegal = legalMoves(root);
+        const int threads = options.threads > 0 ? options.threads : tfe::utils::ThreadPool::hardwareThreads();
+        const auto deadline = options.timeLimitMs > 0 ? start + std::chrono::milliseconds(options.timeLimitMs) : Clock::time_point::max();
+        const uint64_t perThread = options.maxPlayouts > 0 ? std::max<uint64_t>(1, options.maxPlayouts / static_cast<uint64_t>(threads)) : 0;
+
+        tfe::utils::RandomGenerator seeds(options.seed != 0 ? options.seed : tfe::utils::RandomGenerator::randomSeed());
+        // A playout adds at most 5 nodes (a decision node and its 4 chance children), so a playout budget caps the tree
+        std::size_t nodeLimit = std::max<std::size_t>(options.arenaNodes, 16);
+        if (perThread > 0 && perThread < nodeLimit / 5) nodeLimit = 5 + 5 * static_cast<std::size_t>(perThread);
+        std::vector<std::unique_ptr<NodeArena>> trees(static_cast<std::size_t>(threads));
+        for (auto& tree : trees) tree = arenaPool().acquire();
+        std::vector<uint64_t> playouts(static_cast<std::size_t>(threads), 0);
+
+        const auto searchTree = [&](const int t, tfe::utils::RandomGenerator rng) {
+            NodeArena& arena = *trees[static_cast<std::size_t>(t)];
+            arena.reset(nodeLimit);
+            arena.allocate(1);
+            arena[0].board = root;
+            arena[0].legal = rootLegal;
+
+            TreeSearch search{arena, rng, options, {}};
+            uint64_t done = 0;
+            while (perThread == 0 || done < perThread) {
+                // Every tree completes a playout, even when setting up its arena used up the budget
+                if (done != 0 && done % CLOCK_CHECK_INTERVAL == 0 && Clock::now() >= deadline) break;
+                search.playout();
+                ++done;
+            }
+            playouts[static_cast<std::size_t>(t)] = done;
+        };
+
+        if (rootLegal != 0) {
+            if (threads > 1) {
+                tfe::utils::TaskGroup group(tfe::utils::ThreadPool::shared(threads));
+                for (int t = 0; t < threads; ++t) {
+                    seeds.jump();  // Non-overlapping stream per tree
+                    group.run([&, t, rng = seeds] { searchTree(t, rng); });
+                }
+                group.wait();
+            } else {
+                searchTree(0, seeds);
+            }
+        }
+
+        // Sum the root moves over the trees
+        uint64_t visits[4] = {};
+        double values[4] = {};
+        uint64_t nodes = 0;
+        for (int t = 0; t < threads && rootLegal != 0; ++t) {
+            NodeArena& arena = *trees[static_cast<std::size_t>(t)];
+            nodes += arena.used();
+            if (arena[0].firstChild == NONE) continue;
+            for (int dir = 0; dir < 4; ++dir) {
+                const Node& child = arena[arena[0].firstChild + dir];
+                visits[dir] += child.visits;
+                values[dir] += child.valueSum;
+            }
+        }
+
+        auto best = rootLegal != 0 ? static_cast<Direction>(std::countr_zero(rootLegal)) : Direction::Up;
+        for (int dir = 0; dir < 4; ++dir) {
+            if (!((rootLegal >> dir) & 1) || visits[dir] == 0) continue;
+            const int b = static_cast<int>(best);
+            // Most playouts; the mean score breaks ties
+            if (visits[dir] > visits[b] || (visits[dir] == visits[b] && values[dir] / visits[dir] > values[b] / std::max<uint64_t>(visits[b], 1))) {
+                best = static_cast<Direction>(dir);
+            }
+        }
+
+        for (auto& tree : trees) arenaPool().release(std::move(tree));
+
+        if (stats) {
+            *stats = {};
+            for (const uint64_t p : playouts) stats->playouts += p;
+            stats->nodes = nodes;
+            stats->totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            for (int dir = 0; dir < 4; ++dir) {
+                stats->rootVisits[dir] = visits[dir];
+                stats->rootValue[dir] = visits[dir] != 0 ? values[dir] / static_cast<double>(visits[dir]) : 0.0;
+            }
+        }
+        return best;
+    }
+
+}  // namespace tfe::core
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "board.h"
+
+namespace tfe::core {
+
+    /**
+     * @struct MCTSOptions
+     * @brief Budget and tuning of MCTSSolver. The search stops at whichever budget runs out first.
+     */
+    struct MCTSOptions {
+        // Root parallelization: every thread grows its own tree from the same root and the root statistics are
+        // summed at the end, so threads never share a node (0 = all hardware threads).
+        int threads = 1;
+
+        // Wall-clock budget per move (0 = none; maxPlayouts must then be set).
+        int timeLimitMs = 200;
+
+        // Playouts per move over all threads, split evenly between them (0 = unlimited). With no time limit the
+        // result only depends on the board, seed and thread count.
+        std::uint64_t maxPlayouts = 0;
+
+        // UCB1 exploration constant; child means are rescaled to [0, 1] between the worst and best sibling first.
+        float exploration = 2.0f;
+
+        // Random moves per rollout (0 = until the game is over). The rollout value is the score it collects.
+        int maxRolloutMoves = 0;
+
+        // Node capacity of each thread's arena (40 bytes per node, so 40 MB by default). Memory grows with the tree,
+        // and a playout budget lowers the cap to the 5 nodes per playout it can add. A full arena stops growing
+        // the tree; playouts continue from the existing leaves.
+        std::size_t arenaNodes = std::size_t{1} << 20;
+
+        // Random stream of the search (0 = seeded from std::random_device).
+        std::uint64_t seed = 0;
+    };
+
+    /**
+     * @struct MCTSStats
+     * @brief What one MCTSSolver::findBestMove call did, summed over its threads.
+     */
+    struct MCTSStats {
+        std::uint64_t playouts = 0;
+        std::uint64_t nodes = 0;  // Tree nodes allocated
+        double totalMs = 0;
+
+        // Per direction (indexed by static_cast<int>(Direction)): playouts through the root move and their mean score
+        std::uint64_t rootVisits[4] = {};
+        double rootValue[4] = {};
+    };
+
+    /**
+     * @class MCTSSolver
+     * @brief Anytime Monte Carlo tree search: an alternative to AISolver's depth-limited expectimax.
+     *
+     * Decision nodes (the player to move) have one chance node per legal move, holding the afterstate and the
+     * merge reward. Chance nodes get a decision child for every spawn a playout samples, so likely spawns are
+     * explored first. Each playout descends by UCB1, adds one node, finishes with a random rollout on the
+     * move tables and backs up the score collected from each node on. The move with the most playouts wins.
+     *
+     * Nodes live in an arena per tree, leased from a pool and reused from move to move: allocation is a bump of
+     * an index and releasing a tree is O(1). Trees beyond 64K nodes (2.5 MB) free their memory when the call
+     * returns instead of staying in the pool. Concurrent calls (e.g. games played side by side) are safe.
+     */
+    class MCTSSolver {
+    public:
+        /**
+         * @brief Finds the best move for @p board within the budget of @p options.
+         * @param stats Filled with what the search did when not null.
+         * @return The most visited move (the first legal move when the game is over). Every tree completes at
+         *         least one playout, so a tiny time limit can be overshot by one rollout per thread.
+         */
+        static Direction findBestMove(const Board& board, const MCTSOptions& options = {}, MCTSStats* stats = nullptr);
+    };
+
+}  // namespace tfe::core
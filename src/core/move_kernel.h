@@ -0,0 +1,138 @@
+#pragma once
+#include "bitboard.h"
+#include "config.h"
+#include "lookup_table.h"
+#include "types.h"
+
+namespace tfe::core {
+
+    // The one move implementation shared by Board, BoardBatch, AISolver and the Python bindings.
+
+    /**
+     * @struct MoveSet
+     * @brief All four afterstates of a board, indexed by static_cast<int>(Direction).
+     */
+    struct MoveSet {
+        Bitboard after[4];  // Board after sliding (no spawn)
+        int reward[4];      // Merge score from scoreTable
+        uint8_t legal;      // Bit d is set when direction d changes the board
+    };
+
+    inline bool isLegal(const MoveSet& moves, const Direction dir) { return (moves.legal >> static_cast<int>(dir)) & 1; }
+
+    /**
+     * @brief Computes every direction in one pass: each row and column is extracted once and
+     *        feeds both of its table lookups (Left/Right or Up/Down) and one score lookup.
+     *
+     * Split layout: separate row, column and score tables.
+     */
+    inline MoveSet computeMovesSplit(const Bitboard board) {
+        Bitboard up = 0, down = 0, left = 0, right = 0;
+        int rowReward = 0, colReward = 0;
+        for (int i = 0; i < 4; ++i) {
+            const Row row = (board >> (i * 16)) & Config::ROW_MASK;
+            const Row col = extractColumn(board, i);
+            left |= static_cast<Bitboard>(LookupTable::moveLeftTable[row]) << (i * 16);
+            right |= static_cast<Bitboard>(LookupTable::moveRightTable[row]) << (i * 16);
+            up |= LookupTable::moveUpCol[col] << (i * 4);
+            down |= LookupTable::moveDownCol[col] << (i * 4);
+            // Merge score does not depend on the slide direction along a line
+            rowReward += LookupTable::scoreTable[row];
+            colReward += LookupTable::scoreTable[col];
+        }
+
+        MoveSet moves{{up, down, left, right}, {colReward, colReward, rowReward, rowReward}, 0};
+        for (int d = 0; d < 4; ++d) moves.legal |= static_cast<uint8_t>((moves.after[d] != board) << d);
+        return moves;
+    }
+
+    /**
+     * @brief computeMoves on the packed layout: one 256 KB table, one entry carries both the
+     *        moved row and its reward, right/down moves go through reverseRow.
+     */
+    inline MoveSet computeMovesPacked(const Bitboard board) {
+        Bitboard up = 0, down = 0, left = 0, right = 0;
+        uint32_t rowReward = 0, colReward = 0;
+        for (int i = 0; i < 4; ++i) {
+            const Row row = (board >> (i * 16)) & Config::ROW_MASK;
+            const Row col = extractColumn(board, i);
+            const uint32_t rowEntry = LookupTable::packedMoveTable[row];
+            const uint32_t colEntry = LookupTable::packedMoveTable[col];
+            const Row rowRight = reverseRow(static_cast<Row>(LookupTable::packedMoveTable[reverseRow(row)]));
+            const Row colDown = reverseRow(static_cast<Row>(LookupTable::packedMoveTable[reverseRow(col)]));
+            left |= static_cast<Bitboard>(rowEntry & 0xFFFF) << (i * 16);
+            right |= static_cast<Bitboard>(rowRight) << (i * 16);
+            up |= unpackColumn(static_cast<Row>(colEntry)) << (i * 4);
+            down |= unpackColumn(colDown) << (i * 4);
+            rowReward += rowEntry >> 16;
+            colReward += colEntry >> 16;
+        }
+
+        const int rowScore = static_cast<int>(rowReward << LookupTable::PACKED_REWARD_SHIFT);
+        const int colScore = static_cast<int>(colReward << LookupTable::PACKED_REWARD_SHIFT);
+        MoveSet moves{{up, down, left, right}, {colScore, colScore, rowScore, rowScore}, 0};
+        for (int d = 0; d < 4; ++d) moves.legal |= static_cast<uint8_t>((moves.after[d] != board) << d);
+        return moves;
+    }
+
+    /**
+     * @brief Single-direction variant of computeMovesSplit for callers that already know the move.
+     * @param reward Receives the merge score.
+     * @return The afterstate (equal to @p board when the move is illegal).
+     */
+    inline Bitboard moveBoardSplit(const Bitboard board, const Direction dir, int& reward) {
+        Bitboard result = 0;
+        reward = 0;
+        if (dir == Direction::Up || dir == Direction::Down) {
+            const Bitboard* table = (dir == Direction::Up) ? LookupTable::moveUpCol : LookupTable::moveDownCol;
+            for (int c = 0; c < 4; ++c) {
+                const Row col = extractColumn(board, c);
+                result |= table[col] << (c * 4);
+                reward += LookupTable::scoreTable[col];
+            }
+        } else {
+            const Row* table = (dir == Direction::Left) ? LookupTable::moveLeftTable : LookupTable::moveRightTable;
+            for (int r = 0; r < 4; ++r) {
+                const Row row = (board >> (r * 16)) & Config::ROW_MASK;
+                result |= static_cast<Bitboard>(table[row]) << (r * 16);
+                reward += LookupTable::scoreTable[row];
+            }
+        }
+        return result;
+    }
+
+    // Single-direction variant of computeMovesPacked
+    inline Bitboard moveBoardPacked(const Bitboard board, const Direction dir, int& reward) {
+        const bool vertical = (dir == Direction::Up || dir == Direction::Down);
+        const bool reverse = (dir == Direction::Right || dir == Direction::Down);
+        Bitboard result = 0;
+        uint32_t rewardUnits = 0;
+        for (int i = 0; i < 4; ++i) {
+            const Row line = vertical ? extractColumn(board, i) : static_cast<Row>((board >> (i * 16)) & Config::ROW_MASK);
+            const uint32_t entry = LookupTable::packedMoveTable[reverse ? reverseRow(line) : line];
+            const Row moved = reverse ? reverseRow(static_cast<Row>(entry)) : static_cast<Row>(entry);
+            result |= vertical ? (unpackColumn(moved) << (i * 4)) : (static_cast<Bitboard>(moved) << (i * 16));
+            rewardUnits += entry >> 16;
+        }
+        reward = static_cast<int>(rewardUnits << LookupTable::PACKED_REWARD_SHIFT);
+        return result;
+    }
+
+    // The kernels used by the engine; TFE_PACKED_TABLES selects the cache-compact layout.
+    inline MoveSet computeMoves(const Bitboard board) {
+#if defined(TFE_PACKED_TABLES)
+        return computeMovesPacked(board);
+#else
+        return computeMovesSplit(board);
+#endif
+    }
+
+    inline Bitboard moveBoard(const Bitboard board, const Direction dir, int& reward) {
+#if defined(TFE_PACKED_TABLES)
+        return moveBoardPacked(board, dir, reward);
+#else
+        return moveBoardSplit(board, dir, reward);
+#endif
+    }
+
+}  // namespace tfe::core
@@ -0,0 +1,147 @@
+#include "ntuple_network.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "bitboard.h"
+
+namespace tfe::core {
+
+    NTupleNetwork::NTupleNetwork(const std::vector<Tuple>& tuples, const bool symmetric) : symmetric_(symmetric) {
+        std::size_t offset = 0;
+        for (Tuple cells : tuples) {
+            std::sort(cells.begin(), cells.end());
+            const bool valid = !cells.empty() && cells.size() <= 8 && cells.front() >= 0 && cells.back() < 16 &&
+                               std::adjacent_find(cells.begin(), cells.end()) == cells.end();
+            if (!valid) throw std::invalid_argument("NTupleNetwork: a tuple needs 1-8 distinct cells in 0..15");
+
+            Feature feature;
+            for (const int cell : cells) feature.mask |= uint64_t{0xF} << (4 * cell);
+            feature.cells = std::move(cells);
+            feature.offset = offset;
+            offset += std::size_t{1} << (4 * feature.cells.size());
+            features_.push_back(std::move(feature));
+        }
+        weights_.assign(offset, 0.0f);
+    }
+
+    std::vector<NTupleNetwork::Tuple> NTupleNetwork::standardTuples() {
+        return {
+            {0, 1, 2, 3, 4, 5},   // Top row + two below
+            {4, 5, 6, 7, 8, 9},   // Second row + two below
+            {0, 1, 2, 4, 5, 6},   // 2x3 corner rectangle
+            {4, 5, 6, 8, 9, 10},  // 2x3 inner rectangle
+        };
+    }
+
+    std::size_t NTupleNetwork::tupleIndex(const std::size_t t, const Bitboard board) const {
+        const Feature& feature = features_[t];
+#if defined(__BMI2__)
+        return static_cast<std::size_t>(_pext_u64(board, feature.mask));
+#else
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < feature.cells.size(); ++i) {
+            index |= static_cast<std::size_t>((board >> (4 * feature.cells[i])) & 0xF) << (4 * i);
+        }
+        return index;
+#endif
+    }
+
+    int NTupleNetwork::orientations(const Bitboard board, Bitboard out[8]) const {
+        if (!symmetric_) {
+            out[0] = board;
+            return 1;
+        }
+        symmetries(board, out);
+        return 8;
+    }
+
+    float NTupleNetwork::evaluate(const Bitboard board) const {
+        Bitboard boards[8];
+        const int count = orientations(board, boards);
+        float value = 0;
+        for (std::size_t t = 0; t < features_.size(); ++t) {
+            const float* table = weights_.data() + features_[t].offset;
+            for (int s = 0; s < count; ++s) value += table[tupleIndex(t, boards[s])];
+        }
+        return value;
+    }
+
+    void NTupleNetwork::update(const Bitboard board, const float delta) {
+        Bitboard boards[8];
+        const int count = orientations(board, boards);
+        for (std::size_t t = 0; t < features_.size(); ++t) {
+            float* table = weights_.data() + features_[t].offset;
+            for (int s = 0; s < count; ++s) table[tupleIndex(t, boards[s])] += delta;
+        }
+    }
+
+    // Layout: "NTN1", uint32 tuple count, uint32 symmetric, per tuple (uint32 size, int32 cells...), then the float weights
+    bool NTupleNetwork::save(const char* filepath) const {
+        std::ofstream file(filepath, std::ios::binary);
+        if (!file.is_open()) return false;
+        const auto writeU32 = [&](const uint32_t v) { file.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+        file.write("NTN1", 4);
+        writeU32(static_cast<uint32_t>(features_.size()));
+        writeU32(symmetric_ ? 1 : 0);
+        for (const Feature& feature : features_) {
+            writeU32(static_cast<uint32_t>(feature.cells.size()));
+            for (const int cell : feature.cells) writeU32(static_cast<uint32_t>(cell));
+        }
+        file.write(reinterpret_cast<const char*>(weights_.data()), static_cast<std::streamsize>(sizeBytes()));
+        return static_cast<bool>(file);
+    }
+
+    bool NTupleNetwork::load(const char* filepath, NTupleNetwork& network) {
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "[Core] Warning: Could not open n-tuple network: " << filepath << "\n";
+            return false;
+        }
+        if (!readNetwork(file, network)) {
+            std::cerr << "[Core] Error: Invalid or truncated n-tuple network: " << filepath << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool NTupleNetwork::readNetwork(std::istream& file, NTupleNetwork& network) {
+        const auto readU32 = [&](uint32_t& v) { return static_cast<bool>(file.read(reinterpret_cast<char*>(&v), sizeof(v))); };
+
+        char magic[4];
+        uint32_t tupleCount = 0, symmetric = 0;
+        if (!file.read(magic, 4) || std::memcmp(magic, "NTN1", 4) != 0 || !readU32(tupleCount) || !readU32(symmetric) || tupleCount > 64) return false;
+        std::vector<Tuple> tuples(tupleCount);
+        std::size_t weightCount = 0;
+        for (Tuple& tuple : tuples) {
+            uint32_t size = 0;
+            if (!readU32(size) || size == 0 || size > 8) return false;
+            tuple.resize(size);
+            for (int& cell : tuple) {
+                uint32_t value = 0;
+                if (!readU32(value) || value >= 16) return false;
+                cell = static_cast<int>(value);
+            }
+            weightCount += std::size_t{1} << (4 * size);  // 4 bits per cell
+        }
+
+        // The header alone may declare up to 64 x 16^8 weights: check the file holds them before allocating
+        const std::streampos weightsStart = file.tellg();
+        if (weightsStart < 0 || !file.seekg(0, std::ios::end)) return false;
+        const std::streamoff available = file.tellg() - weightsStart;
+        if (!file.seekg(weightsStart) || available < 0 || static_cast<uint64_t>(available) / sizeof(float) < weightCount) return false;
+
+        try {
+            NTupleNetwork loaded(tuples, symmetric != 0);
+            if (!file.read(reinterpret_cast<char*>(loaded.weights_.data()), static_cast<std::streamsize>(loaded.sizeBytes()))) return false;
+            network = std::move(loaded);
+        } catch (const std::invalid_argument&) {
+            return false;  // Repeated cells
+        }
+        return true;
+    }
+
+}  // namespace tfe::core
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "types.h"
+
+namespace tfe::core {
+
+    /**
+     * @class NTupleNetwork
+     * @brief Learned board evaluator: a sum of weight-table lookups, one per n-tuple of cells.
+     *
+     * Each tuple is a set of cells; the tile exponents on those cells, packed 4 bits apiece, index
+     * the tuple's own table (16^n entries, so a 6-tuple owns 16M weights). With symmetric sampling
+     * every tuple is also read on the 7 rotated/reflected boards, so one table learns all 8
+     * orientations of its pattern and the value is symmetry-invariant.
+     *
+     * Cells are numbered row * 4 + col, like the bitboard nibbles. A tuple's index is its nibbles in
+     * ascending cell order, which BMI2 extracts with a single pext.
+     */
+    class NTupleNetwork {
+    public:
+        using Tuple = std::vector<int>;
+
+        /**
+         * @brief Zero-initialized network.
+         * @param tuples Cell sets (1 to 8 distinct cells in 0..15 each; the order inside a tuple does not matter).
+         * @param symmetric Also evaluate every tuple on the 8 symmetries of the board.
+         */
+        explicit NTupleNetwork(const std::vector<Tuple>& tuples, bool symmetric = true);
+
+        // The four 6-tuples (two straight, two 2x3 rectangles) used by the strong TD-learned agents: 4 x 64 MB.
+        static std::vector<Tuple> standardTuples();
+
+        float evaluate(Bitboard board) const;
+
+        // Adds @p delta to every weight that evaluate(board) reads (TD learning; scale delta by the learning rate).
+        void update(Bitboard board, float delta);
+
+        /**
+         * @brief Saves tuples, the symmetry flag and all weights ("NTN1" binary format).
+         * @return False when the file cannot be written.
+         */
+        bool save(const char* filepath) const;
+
+        /**
+         * @brief Loads a network written by save(); @p network is untouched on failure.
+         * @return False when the file is missing, malformed or truncated.
+         */
+        static bool load(const char* filepath, NTupleNetwork& network);
+
+        std::size_t tupleCount() const { return features_.size(); }
+        bool symmetric() const { return symmetric_; }
+        std::size_t weightCount() const { return weights_.size(); }
+        std::size_t sizeBytes() const { return weights_.size() * sizeof(float); }
+
+        // Weight index of tuple @p t on @p board, relative to the tuple's table
+        std::size_t tupleIndex(std::size_t t, Bitboard board) const;
+
+    private:
+        struct Feature {
+            Tuple cells;          // Ascending
+            uint64_t mask = 0;    // Nibble mask of the cells
+            std::size_t offset = 0;
+        };
+
+        static bool readNetwork(std::istream& file, NTupleNetwork& network);
+
+        // The boards every tuple is read on: the board itself, plus its 7 symmetries when symmetric_
+        int orientations(Bitboard board, Bitboard out[8]) const;
+
+        std::vector<Feature> features_;
+        bool symmetric_ = true;
+        std::vector<float> weights_;
+    };
+
+}  // namespace tfe::core
@@ -0,0 +1,160 @@
+#include "opening_book.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "bitboard.h"
+#include "move_kernel.h"
+
+namespace tfe::core {
+
+    namespace {
+
+        // Layout: "TFB1", uint32 reserved (0), uint64 count, count sorted uint64 keys, count uint8 moves.
+        // The 16-byte header keeps the key array 8-byte aligned inside the mapping.
+        constexpr char MAGIC[4] = {'T', 'F', 'B', '1'};
+        constexpr std::size_t HEADER_BYTES = 16;
+
+        /**
+         * Move on @p to that matches @p move on @p from, @p to being one of the 8 orientations of @p from:
+         * the symmetry that turns from into to turns the afterstate of @p move into an afterstate of @p to.
+         * nullopt when @p move is illegal on @p from or @p to is not an orientation of it.
+         */
+        std::optional<Direction> translateMove(const Bitboard from, const Direction move, const Bitboard to) {
+            const MoveSet fromMoves = computeMoves(from);
+            if (!isLegal(fromMoves, move)) return std::nullopt;
+            if (from == to) return move;
+
+            Bitboard orientations[8];
+            symmetries(from, orientations);
+            const int s = static_cast<int>(std::find(orientations, orientations + 8, to) - orientations);
+            if (s == 8) return std::nullopt;
+
+            Bitboard target[8];
+            symmetries(fromMoves.after[static_cast<int>(move)], target);
+            const MoveSet toMoves = computeMoves(to);
+            for (uint8_t legal = toMoves.legal; legal != 0; legal &= legal - 1) {
+                const int dir = std::countr_zero(legal);
+                if (toMoves.after[dir] == target[s]) return static_cast<Direction>(dir);
+            }
+            return std::nullopt;
+        }
+
+    }  // namespace
+
+    OpeningBook::~OpeningBook() { close(); }
+
+    bool OpeningBook::open(const char* filepath) {
+        close();
+
+#ifdef _WIN32
+        const HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            std::cerr << "[Core] Warning: Could not open opening book: " << filepath << "\n";
+            return false;
+        }
+        fileHandle_ = file;
+        LARGE_INTEGER size{};
+        GetFileSizeEx(file, &size);
+        mappingBytes_ = static_cast<std::size_t>(size.QuadPart);
+        if (mappingBytes_ >= HEADER_BYTES) {
+            mappingHandle_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mappingHandle_) mapping_ = MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0);
+        }
+#else
+        const int fd = ::open(filepath, O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "[Core] Warning: Could not open opening book: " << filepath << "\n";
+            return false;
+        }
+        struct stat st {};
+        mappingBytes_ = ::fstat(fd, &st) == 0 ? static_cast<std::size_t>(st.st_size) : 0;
+        if (mappingBytes_ >= HEADER_BYTES) {
+            void* view = ::mmap(nullptr, mappingBytes_, PROT_READ, MAP_SHARED, fd, 0);
+            if (view != MAP_FAILED) mapping_ = view;
+        }
+        ::close(fd);  // The mapping keeps the file alive
+#endif
+
+        bool valid = mapping_ != nullptr;
+        if (valid) {
+            const auto* bytes = static_cast<const char*>(mapping_);
+            uint64_t count = 0;
+            std::memcpy(&count, bytes + 8, sizeof(count));
+            valid = std::memcmp(bytes, MAGIC, 4) == 0 && count <= (mappingBytes_ - HEADER_BYTES) / 9 &&
+                    mappingBytes_ == HEADER_BYTES + count * 9;
+            if (valid) {
+                count_ = static_cast<std::size_t>(count);
+                keys_ = reinterpret_cast<const Bitboard*>(bytes + HEADER_BYTES);
+                moves_ = reinterpret_cast<const uint8_t*>(bytes + HEADER_BYTES + count_ * sizeof(Bitboard));
+            }
+        }
+        if (!valid) {
+            std::cerr << "[Core] Error: Invalid or truncated opening book: " << filepath << "\n";
+            close();
+        }
+        return valid;
+    }
+
+    void OpeningBook::close() {
+#ifdef _WIN32
+        if (mapping_) UnmapViewOfFile(mapping_);
+        if (mappingHandle_) CloseHandle(mappingHandle_);
+        if (fileHandle_) CloseHandle(fileHandle_);
+        mappingHandle_ = nullptr;
+        fileHandle_ = nullptr;
+#else
+        if (mapping_) ::munmap(mapping_, mappingBytes_);
+#endif
+        mapping_ = nullptr;
+        mappingBytes_ = 0;
+        keys_ = nullptr;
+        moves_ = nullptr;
+        count_ = 0;
+    }
+
+    std::optional<Direction> OpeningBook::probe(const Bitboard board) const {
+        if (count_ == 0) return std::nullopt;
+        const Bitboard key = canonicalBoard(board);
+        const Bitboard* it = std::lower_bound(keys_, keys_ + count_, key);
+        if (it == keys_ + count_ || *it != key) return std::nullopt;
+        const uint8_t move = moves_[it - keys_];
+        if (move > static_cast<uint8_t>(Direction::Right)) return std::nullopt;
+        return translateMove(key, static_cast<Direction>(move), board);
+    }
+
+    std::size_t OpeningBook::write(const char* filepath, const std::vector<Entry>& entries) {
+        std::vector<std::pair<Bitboard, uint8_t>> book;
+        book.reserve(entries.size());
+        for (const Entry& entry : entries) {
+            const Bitboard key = canonicalBoard(entry.board);
+            if (const auto move = translateMove(entry.board, entry.move, key)) book.emplace_back(key, static_cast<uint8_t>(*move));
+        }
+        std::stable_sort(book.begin(), book.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        book.erase(std::unique(book.begin(), book.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), book.end());
+
+        std::ofstream file(filepath, std::ios::binary);
+        if (!file.is_open()) return 0;
+        const uint32_t reserved = 0;
+        const uint64_t count = book.size();
+        file.write(MAGIC, 4);
+        file.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (const auto& [key, move] : book) file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        for (const auto& [key, move] : book) file.put(static_cast<char>(move));
+        return file ? book.size() : 0;
+    }
+
+}  // namespace tfe::core
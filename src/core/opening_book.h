@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "types.h"
+
+namespace tfe::core {
+
+    /**
+     * @class OpeningBook
+     * @brief Read-only book of precomputed best moves for frequent positions, memory-mapped from disk.
+     *
+     * Positions are stored once per symmetry class, keyed by canonicalBoard(), with the move for that
+     * canonical orientation; probe() maps it back onto the board it was asked about. The file is a sorted
+     * key array followed by a move array, so opening costs one mmap and a probe is a binary search over
+     * pages the OS loads on demand and shares between processes.
+     *
+     * Built offline by the 2048-book tool (deep searches of the positions self-play visits most often);
+     * plugged into AISolver through SearchOptions::book.
+     */
+    class OpeningBook {
+    public:
+        struct Entry {
+            Bitboard board = 0;
+            Direction move = Direction::Up;
+        };
+
+        OpeningBook() = default;
+        ~OpeningBook();
+
+        OpeningBook(const OpeningBook&) = delete;
+        OpeningBook& operator=(const OpeningBook&) = delete;
+
+        /**
+         * @brief Maps a book file, replacing the current one.
+         * @return False (with a message on stderr) when the file is missing or malformed; the book is then empty.
+         */
+        bool open(const char* filepath);
+
+        void close();
+
+        bool isOpen() const { return mapping_ != nullptr; }
+
+        // Positions in the book (symmetry classes)
+        std::size_t size() const { return count_; }
+
+        /**
+         * @brief The book move for @p board in any of its 8 orientations, nullopt on a miss.
+         *        A hit is always legal on @p board.
+         */
+        std::optional<Direction> probe(Bitboard board) const;
+
+        /**
+         * @brief Writes a book file. Boards may be in any orientation: they are canonicalized (with their move),
+         *        sorted and deduplicated, the first entry of a symmetry class winning. Illegal moves are dropped.
+         * @return The number of positions written, 0 when the file cannot be written.
+         */
+        static std::size_t write(const char* filepath, const std::vector<Entry>& entries);
+
+    private:
+        void* mapping_ = nullptr;  // Whole file, read-only
+        std::size_t mappingBytes_ = 0;
+#ifdef _WIN32
+        void* fileHandle_ = nullptr;
+        void* mappingHandle_ = nullptr;
+#endif
+        const Bitboard* keys_ = nullptr;  // Sorted canonical boards
+        const uint8_t* moves_ = nullptr;  // Direction of keys_[i] in its canonical orientation
+        std::size_t count_ = 0;
+    };
+
+}  // namespace tfe::core
@@ -0,0 +1,58 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+
+namespace tfe::core {
+
+    // Heuristic weights (referenced from nneonneo)
+    // Later we will use RL to refine these numbers
+    namespace Heuristic {
+        constexpr float LOST_PENALTY = 200000.0f;
+        constexpr float MONOTONICITY_POWER = 4.0f;
+        constexpr float MONOTONICITY_WEIGHT = 47.0f;
+        constexpr float SUM_POWER = 3.5f;
+        constexpr float SUM_WEIGHT = 11.0f;
+        constexpr float MERGES_WEIGHT = 700.0f;
+        constexpr float EMPTY_WEIGHT = 270.0f;
+    }  // namespace Heuristic
+
+    /**
+     * @brief Heuristic score of one line of @p n tile exponents (empty cells, merges, monotonicity, sum).
+     *
+     * lookup-table-gen tabulates it for 4-tile rows; the other board sizes use it directly or
+     * through their own line tables.
+     */
+    inline float lineHeuristic(const int* line, const int n) {
+        float sum = 0;
+        int empty = 0;
+        int merges = 0;
+        int prev = 0;
+        int counter = 0;
+
+        for (int i = 0; i < n; ++i) {
+            const int val = line[i];
+            sum += std::pow(val, Heuristic::SUM_POWER);
+            if (val == 0) {
+                empty++;
+            } else {
+                if (prev == val) counter++;
+                else if (counter > 0) { merges += 1 + counter; counter = 0; }
+                prev = val;
+            }
+        }
+        if (counter > 0) merges += 1 + counter;
+
+        float mono_left = 0, mono_right = 0;
+        for (int i = 1; i < n; ++i) {
+            if (line[i-1] > line[i]) mono_left += std::pow(line[i-1], Heuristic::MONOTONICITY_POWER) - std::pow(line[i], Heuristic::MONOTONICITY_POWER);
+            else mono_right += std::pow(line[i], Heuristic::MONOTONICITY_POWER) - std::pow(line[i-1], Heuristic::MONOTONICITY_POWER);
+        }
+
+        return Heuristic::LOST_PENALTY +
+            Heuristic::EMPTY_WEIGHT * empty +
+            Heuristic::MERGES_WEIGHT * merges -
+            Heuristic::MONOTONICITY_WEIGHT * std::min(mono_left, mono_right) -
+            Heuristic::SUM_WEIGHT * sum;
+    }
+
+}  // namespace tfe::core
@@ -0,0 +1,97 @@
+#include "sized_board.h"
+
+#include "config.h"
+
+namespace tfe::core {
+
+    template <int N>
+    const LineTables<N>& LineTables<N>::get() {
+        // Built once per process on first use (thread-safe static initialization)
+        static const LineTables tables = [] {
+            using L = SizedLayout<N>;
+            constexpr std::size_t entries = std::size_t{1} << L::ROW_BITS;
+            LineTables t;
+            t.left.resize(entries);
+            t.right.resize(entries);
+            t.reward.resize(entries);
+            t.heuristic.resize(entries);
+            for (uint32_t line = 0; line < entries; ++line) {
+                t.left[line] = slideLineLeft<N>(line, t.reward[line]);
+                t.heuristic[line] = lineHeuristic<N>(line);
+            }
+            // Right = mirrored left; the merge score is the same in both directions, so reward serves both
+            for (uint32_t line = 0; line < entries; ++line) t.right[line] = L::reverseLine(t.left[L::reverseLine(line)]);
+            return t;
+        }();
+        return tables;
+    }
+
+    template struct LineTables<3>;
+    template struct LineTables<5>;
+
+    template <int N>
+    SizedBoard<N>::SizedBoard() : SizedBoard(tfe::utils::RandomGenerator::randomSeed()) {}
+
+    template <int N>
+    SizedBoard<N>::SizedBoard(const uint64_t seed) : rng_(seed) {
+        reset();
+    }
+
+    template <int N>
+    void SizedBoard<N>::reset() {
+        board_ = Storage{};
+        score_ = 0;
+        spawnRandomTile();
+        spawnRandomTile();
+    }
+
+    template <int N>
+    Grid SizedBoard<N>::getGrid() const {
+        Grid result(N, std::vector<int>(N));
+        for (int r = 0; r < N; ++r) {
+            for (int c = 0; c < N; ++c) {
+                const Tile t = getTile(r, c);
+                result[r][c] = (t == 0) ? 0 : (1 << t);
+            }
+        }
+        return result;
+    }
+
+    template <int N>
+    bool SizedBoard<N>::move(const Direction dir) {
+        int reward;
+        const Storage next = moveSized<N>(board_, dir, reward);
+        if (next == board_) return false;
+        board_ = next;
+        score_ += reward;
+        spawnRandomTile();
+        return true;
+    }
+
+    template <int N>
+    void SizedBoard<N>::spawnRandomTile() {
+        int counts[Layout::WORDS];
+        int total = 0;
+        for (int w = 0; w < Layout::WORDS; ++w) {
+            counts[w] = std::popcount(Layout::emptyCells(board_, w));
+            total += counts[w];
+        }
+        if (total == 0) return;
+
+        int k = rng_.getInt(0, total - 1);
+        const Tile val = rng_.getBool(Config::SPAWN_PROBABILITY_2) ? Config::TILE_EXPONENT_LOW : Config::TILE_EXPONENT_HIGH;
+        for (int w = 0; w < Layout::WORDS; ++w) {
+            if (k < counts[w]) {
+                Layout::word(board_, w) |= static_cast<uint64_t>(val) << selectEmptyCell(Layout::emptyCells(board_, w), k);
+                return;
+            }
+            k -= counts[w];
+        }
+    }
+
+    template class SizedBoard<3>;
+    template class SizedBoard<4>;
+    template class SizedBoard<5>;
+    template class SizedBoard<6>;
+
+}  // namespace tfe::core
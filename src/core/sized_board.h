@@ -0,0 +1,317 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "bitboard.h"
+#include "lookup_table.h"
+#include "move_kernel.h"
+#include "row_heuristic.h"
+#include "types.h"
+#include "utils/random-generator.h"
+
+namespace tfe::core {
+
+    /**
+     * @struct SizedLayout
+     * @brief Bit layout of an N x N board: 4-bit cells, rows of 4N bits packed into 64-bit words.
+     *
+     * Rows never straddle a word, so every row and cell access is one shift and one mask:
+     * 3x3 and 4x4 fit one uint64_t, 5x5 takes two words (3 + 2 rows) and 6x6 three (2 rows each).
+     * For N = 4 the layout is exactly the Bitboard used by Board.
+     */
+    template <int N>
+    struct SizedLayout {
+        static_assert(N >= 3 && N <= 6, "supported board sizes are 3x3 to 6x6");
+
+        static constexpr int ROW_BITS = 4 * N;
+        static constexpr int ROWS_PER_WORD = 64 / ROW_BITS;
+        static constexpr int WORDS = (N + ROWS_PER_WORD - 1) / ROWS_PER_WORD;
+        static constexpr uint32_t LINE_MASK = (1u << ROW_BITS) - 1;
+
+        using Storage = std::conditional_t<WORDS == 1, uint64_t, std::array<uint64_t, WORDS>>;
+
+        static uint64_t& word(Storage& s, const int i) {
+            if constexpr (WORDS == 1) {
+                (void)i;
+                return s;
+            } else {
+                return s[i];
+            }
+        }
+        static uint64_t word(const Storage& s, const int i) {
+            if constexpr (WORDS == 1) {
+                (void)i;
+                return s;
+            } else {
+                return s[i];
+            }
+        }
+
+        static int cellShift(const int row, const int col) { return (row % ROWS_PER_WORD) * ROW_BITS + col * 4; }
+
+        static Tile getTile(const Storage& s, const int row, const int col) { return (word(s, row / ROWS_PER_WORD) >> cellShift(row, col)) & 0xF; }
+
+        static void setTile(Storage& s, const int row, const int col, const Tile value) {
+            uint64_t& w = word(s, row / ROWS_PER_WORD);
+            w &= ~(uint64_t{0xF} << cellShift(row, col));
+            w |= static_cast<uint64_t>(value) << cellShift(row, col);
+        }
+
+        // A line holds N cells, cell i at bits 4i (rows left to right, columns top to bottom)
+        static uint32_t getRow(const Storage& s, const int row) { return (word(s, row / ROWS_PER_WORD) >> cellShift(row, 0)) & LINE_MASK; }
+        static void orRow(Storage& s, const int row, const uint32_t line) { word(s, row / ROWS_PER_WORD) |= static_cast<uint64_t>(line) << cellShift(row, 0); }
+
+        static uint32_t getColumn(const Storage& s, const int col) {
+            uint32_t line = 0;
+            for (int r = 0; r < N; ++r) line |= static_cast<uint32_t>(getTile(s, r, col)) << (r * 4);
+            return line;
+        }
+        static void orColumn(Storage& s, const int col, const uint32_t line) {
+            for (int r = 0; r < N; ++r) word(s, r / ROWS_PER_WORD) |= static_cast<uint64_t>((line >> (r * 4)) & 0xF) << cellShift(r, col);
+        }
+
+        static uint32_t reverseLine(const uint32_t line) {
+            uint32_t out = 0;
+            for (int i = 0; i < N; ++i) out |= ((line >> (i * 4)) & 0xF) << ((N - 1 - i) * 4);
+            return out;
+        }
+
+        // Cells that exist in word w (the last word of 5x5 is only partly used)
+        static constexpr uint64_t validCells(const int w) {
+            const int rows = (N - w * ROWS_PER_WORD < ROWS_PER_WORD) ? N - w * ROWS_PER_WORD : ROWS_PER_WORD;
+            const int bits = rows * ROW_BITS;
+            return bits == 64 ? 0x1111111111111111ULL : 0x1111111111111111ULL & ((uint64_t{1} << bits) - 1);
+        }
+
+        // emptyMask of word w restricted to real cells: bit 4i set when that cell is empty
+        static uint64_t emptyCells(const Storage& s, const int w) { return emptyMask(word(s, w)) & validCells(w); }
+    };
+
+    /**
+     * @brief Reference slide of one line towards cell 0 (compress, merge equal pairs once, compress).
+     * @param reward Receives the merge score.
+     *
+     * Builds the 3x3 and 5x5 line tables and is the 6x6 kernel, whose 2^24-entry tables would not fit in cache.
+     */
+    template <int N>
+    constexpr uint32_t slideLineLeft(const uint32_t line, int& reward) {
+        uint32_t out = 0;
+        int target = 0;
+        int pending = 0;
+        reward = 0;
+        for (int i = 0; i < N; ++i) {
+            const int v = (line >> (i * 4)) & 0xF;
+            if (v == 0) continue;
+            if (v == pending) {
+                out |= static_cast<uint32_t>(v + 1) << (target++ * 4);
+                reward += 1 << (v + 1);
+                pending = 0;
+            } else {
+                if (pending != 0) out |= static_cast<uint32_t>(pending) << (target++ * 4);
+                pending = v;
+            }
+        }
+        if (pending != 0) out |= static_cast<uint32_t>(pending) << (target * 4);
+        return out;
+    }
+
+    /**
+     * @struct LineTables
+     * @brief Move, reward and heuristic tables for lines of N cells (built on first use: 4096 entries for
+     *        3x3, 2^20 for 5x5). 4x4 uses the generated LookupTable arrays instead.
+     */
+    template <int N>
+    struct LineTables {
+        std::vector<uint32_t> left;
+        std::vector<uint32_t> right;
+        std::vector<int> reward;
+        std::vector<float> heuristic;
+
+        static const LineTables& get();
+    };
+
+    extern template struct LineTables<3>;
+    extern template struct LineTables<5>;
+
+    template <int N>
+    float lineHeuristic(const uint32_t line) {
+        int cells[N];
+        for (int i = 0; i < N; ++i) cells[i] = (line >> (i * 4)) & 0xF;
+        return lineHeuristic(cells, N);
+    }
+
+    /**
+     * @brief Size-specific line kernels: generated tables for 4, runtime tables for 3 and 5,
+     *        direct computation for 6.
+     */
+    template <int N>
+    struct LineKernel {
+        static uint32_t moveLeft(const uint32_t line, int& reward) {
+            if constexpr (N == 4) {
+                reward = LookupTable::scoreTable[line];
+                return LookupTable::moveLeftTable[line];
+            } else if constexpr (N == 6) {
+                return slideLineLeft<N>(line, reward);
+            } else {
+                const LineTables<N>& t = LineTables<N>::get();
+                reward = t.reward[line];
+                return t.left[line];
+            }
+        }
+
+        static uint32_t moveRight(const uint32_t line, int& reward) {
+            if constexpr (N == 4) {
+                reward = LookupTable::scoreTable[line];
+                return LookupTable::moveRightTable[line];
+            } else if constexpr (N == 6) {
+                return SizedLayout<N>::reverseLine(slideLineLeft<N>(SizedLayout<N>::reverseLine(line), reward));
+            } else {
+                const LineTables<N>& t = LineTables<N>::get();
+                reward = t.reward[line];
+                return t.right[line];
+            }
+        }
+
+        static float heuristic(const uint32_t line) {
+            if constexpr (N == 4) {
+                return LookupTable::heuristicTable[line];
+            } else if constexpr (N == 6) {
+                return lineHeuristic<N>(line);
+            } else {
+                return LineTables<N>::get().heuristic[line];
+            }
+        }
+    };
+
+    /**
+     * @brief Moves an N x N board without spawning.
+     * @param reward Receives the merge score.
+     * @return The afterstate (equal to @p board when the move is illegal).
+     */
+    template <int N>
+    typename SizedLayout<N>::Storage moveSized(const typename SizedLayout<N>::Storage& board, const Direction dir, int& reward) {
+        using L = SizedLayout<N>;
+        if constexpr (N == 4) {
+            return moveBoard(board, dir, reward);
+        } else {
+            const bool vertical = (dir == Direction::Up || dir == Direction::Down);
+            const bool reverse = (dir == Direction::Right || dir == Direction::Down);
+            typename L::Storage out{};
+            reward = 0;
+            for (int i = 0; i < N; ++i) {
+                const uint32_t line = vertical ? L::getColumn(board, i) : L::getRow(board, i);
+                int lineReward;
+                const uint32_t moved = reverse ? LineKernel<N>::moveRight(line, lineReward) : LineKernel<N>::moveLeft(line, lineReward);
+                reward += lineReward;
+                if (vertical) L::orColumn(out, i, moved);
+                else L::orRow(out, i, moved);
+            }
+            return out;
+        }
+    }
+
+    /**
+     * @brief SWAR legality test between cells x and their neighbours y (aligned to the same bit positions).
+     * @return Bit 0: some tile can move towards x (Up/Left), bit 1: some tile can move towards y (Down/Right).
+     */
+    inline uint8_t neighbourMoves(const uint64_t x, const uint64_t y, const uint64_t cells) {
+        const uint64_t emptyX = emptyMask(x) & cells, emptyY = emptyMask(y) & cells;
+        const uint64_t tileX = emptyX ^ cells, tileY = emptyY ^ cells;
+        const uint64_t merge = emptyMask(x ^ y) & tileX;
+        return static_cast<uint8_t>((((emptyX & tileY) | merge) != 0) | ((((tileX & emptyY) | merge) != 0) << 1));
+    }
+
+    // Bit d set when Direction d changes the board: the legalMoves SWAR test generalized to multiword layouts
+    template <int N>
+    uint8_t legalMovesSized(const typename SizedLayout<N>::Storage& board) {
+        using L = SizedLayout<N>;
+        if constexpr (N == 4) {
+            return legalMoves(board);
+        } else {
+            constexpr uint64_t LINE_CELLS = 0x1111111111111111ULL & L::LINE_MASK;
+            constexpr uint64_t PAIR_CELLS = LINE_CELLS >> 4;  // cells 0..N-2 of a line
+            uint8_t horizontal = 0, vertical = 0;
+            for (int w = 0; w < L::WORDS; ++w) {
+                const uint64_t x = L::word(board, w);
+                const int rows = (N - w * L::ROWS_PER_WORD < L::ROWS_PER_WORD) ? N - w * L::ROWS_PER_WORD : L::ROWS_PER_WORD;
+                uint64_t rowPairs = 0, hasBelow = 0;
+                for (int r = 0; r < rows; ++r) rowPairs |= PAIR_CELLS << (r * L::ROW_BITS);
+                for (int r = 0; r + 1 < rows; ++r) hasBelow |= LINE_CELLS << (r * L::ROW_BITS);
+
+                horizontal |= neighbourMoves(x, x >> 4, rowPairs);
+                vertical |= neighbourMoves(x, x >> L::ROW_BITS, hasBelow);
+                // The last row of this word sits above the first row of the next one
+                if (w + 1 < L::WORDS) {
+                    const int last = w * L::ROWS_PER_WORD + rows - 1;
+                    vertical |= neighbourMoves(L::getRow(board, last), L::getRow(board, last + 1), LINE_CELLS);
+                }
+            }
+            return static_cast<uint8_t>((vertical & 1) << static_cast<int>(Direction::Up) | (vertical >> 1) << static_cast<int>(Direction::Down) |
+                                        (horizontal & 1) << static_cast<int>(Direction::Left) | (horizontal >> 1) << static_cast<int>(Direction::Right));
+        }
+    }
+
+    /**
+     * @class SizedBoard
+     * @brief Headless N x N game (N = 3..6) on size-specialized bitboard storage and kernels.
+     *
+     * Board stays the 4x4 engine used by the console, GUI and observers; SizedBoard<4> runs on the
+     * same Bitboard and tables, so results compare directly across sizes. There are no events and
+     * no high-score persistence: this is for agents and benchmarks.
+     */
+    template <int N>
+    class SizedBoard {
+    public:
+        using Layout = SizedLayout<N>;
+        using Storage = typename Layout::Storage;
+
+        static constexpr int SIZE = N;
+
+        // Seeds the spawn generator from std::random_device
+        SizedBoard();
+
+        // Deterministic spawns: equal seeds and equal moves replay the same game
+        explicit SizedBoard(uint64_t seed);
+
+        void reset();
+        void seed(uint64_t seed) { rng_.seed(seed); }
+
+        static constexpr int getSize() { return N; }
+
+        Grid getGrid() const;
+        Tile getTile(const int row, const int col) const { return Layout::getTile(board_, row, col); }
+        void setTile(const int row, const int col, const Tile value) { Layout::setTile(board_, row, col, value); }
+
+        bool move(Direction dir);
+        void spawnRandomTile();
+
+        uint8_t legalMoves() const { return legalMovesSized<N>(board_); }
+        bool isGameOver() const { return legalMoves() == 0; }
+
+        int getScore() const { return score_; }
+        Storage getState() const { return board_; }
+        void loadState(const Storage& board, const int score) {
+            board_ = board;
+            score_ = score;
+        }
+
+    private:
+        Storage board_{};
+        int score_ = 0;
+        tfe::utils::RandomGenerator rng_;
+    };
+
+    using Board3 = SizedBoard<3>;
+    using Board4 = SizedBoard<4>;
+    using Board5 = SizedBoard<5>;
+    using Board6 = SizedBoard<6>;
+
+    extern template class SizedBoard<3>;
+    extern template class SizedBoard<4>;
+    extern template class SizedBoard<5>;
+    extern template class SizedBoard<6>;
+
+}  // namespace tfe::core
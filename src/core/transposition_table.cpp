@@ -1,5 +1,8 @@
 #include "transposition_table.h"
 
+#include <bit>
+#include <limits>
+
 namespace tfe::core {
 
     TranspositionTable& TranspositionTable::instance() {
@@ -7,18 +10,134 @@ namespace tfe::core {
         return instance;
     }
 
+    TranspositionTable::TranspositionTable(const std::size_t megabytes) { resize(megabytes); }
+
+    void TranspositionTable::resize(const std::size_t megabytes) {
+        megabytes_ = megabytes;
+        const std::size_t wanted = (megabytes << 20) / sizeof(Bucket);
+        bucketCount_ = wanted > 2 ? std::bit_floor(wanted) : 2;  // At least 2, so shift_ stays below 64
+        shift_ = 64 - std::countr_zero(bucketCount_);
+        buckets_ = std::make_unique<Bucket[]>(bucketCount_);  // Value-initialized: every slot empty
+    }
+
+    uint64_t TranspositionTable::pack(const int depth, const float score) const {
+        const uint64_t clampedDepth = static_cast<uint64_t>(depth < 0 ? 0 : (depth > 0xFF ? 0xFF : depth));
+        return OCCUPIED | (static_cast<uint64_t>(generation_.load(std::memory_order_relaxed)) << 40) | (clampedDepth << 32) | std::bit_cast<uint32_t>(score);
+    }
+
+    uint64_t TranspositionTable::find(const Bitboard board, const uint64_t kind) const {
+        const Bucket& bucket = bucketOf(board);
+        for (const Slot& slot : bucket.slots) {
+            const uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if ((slot.key.load(std::memory_order_relaxed) ^ data) == board && (data & OCCUPIED) && (data & UPPER_BOUND) == kind) return data;
+        }
+        return 0;
+    }
+
     bool TranspositionTable::get(const Bitboard board, const int depth, float& score) const {
-        auto it = table_.find(board);
-        if (it != table_.end()) {
-            if (it->second.depth >= depth) {
-                score = it->second.score;
-                return true;
+#if defined(TFE_SEARCH_STATS)
+        counters_.probes.fetch_add(1, std::memory_order_relaxed);
+#endif
+        const uint64_t data = find(board, 0);
+        if (!(data & OCCUPIED) || depthOf(data) != depth) return false;
+        score = std::bit_cast<float>(static_cast<uint32_t>(data));
+#if defined(TFE_SEARCH_STATS)
+        counters_.hits.fetch_add(1, std::memory_order_relaxed);
+#endif
+        return true;
+    }
+
+    bool TranspositionTable::getUpperBound(const Bitboard board, const int depth, float& bound) const {
+        const uint64_t data = find(board, UPPER_BOUND);
+        if (!(data & OCCUPIED) || depthOf(data) != depth) return false;
+        bound = std::bit_cast<float>(static_cast<uint32_t>(data));
+        return true;
+    }
+
+    void TranspositionTable::put(const Bitboard board, const int depth, const float score) { store(board, pack(depth, score)); }
+
+    void TranspositionTable::putUpperBound(const Bitboard board, const int depth, const float bound) {
+        store(board, pack(depth, bound) | UPPER_BOUND);
+    }
+
+    void TranspositionTable::store(const Bitboard board, const uint64_t data) {
+        Bucket& bucket = bucketOf(board);
+        const int depth = depthOf(data);
+        const bool isBound = (data & UPPER_BOUND) != 0;
+
+        // A board holds at most one exact entry and one bound, in separate slots. A deeper exact entry (or one as
+        // deep, for a bound) is only refreshed to the current generation, and a bound never takes an exact
+        // entry's slot. Otherwise the board's slot of the same kind is overwritten (an exact store also reuses a
+        // bound no deeper than itself), or an empty slot is taken, or the other boards' entry with the lowest
+        // depth - AGE_WEIGHT * age is evicted.
+        Slot* exactSlot = nullptr;
+        Slot* boundSlot = nullptr;
+        Slot* victim = nullptr;
+        int victimValue = std::numeric_limits<int>::max();
+        for (Slot& slot : bucket.slots) {
+            const uint64_t old = slot.data.load(std::memory_order_relaxed);
+            if (!(old & OCCUPIED)) {
+                if (victimValue != std::numeric_limits<int>::min()) {
+                    victim = &slot;
+                    victimValue = std::numeric_limits<int>::min();
+                }
+                continue;
+            }
+            if ((slot.key.load(std::memory_order_relaxed) ^ old) == board) {
+                (old & UPPER_BOUND ? boundSlot : exactSlot) = &slot;
+                continue;
+            }
+            if (const int value = depthOf(old) - AGE_WEIGHT * ageOf(old); value < victimValue) {
+                victim = &slot;
+                victimValue = value;
+            }
+        }
+
+        if (exactSlot) {
+            const uint64_t old = exactSlot->data.load(std::memory_order_relaxed);
+            if (isBound ? depthOf(old) == depth : depthOf(old) > depth) {
+                if (ageOf(old) == 0) return;
+                const uint64_t refreshed = pack(depthOf(old), std::bit_cast<float>(static_cast<uint32_t>(old)));
+                exactSlot->key.store(board ^ refreshed, std::memory_order_relaxed);
+                exactSlot->data.store(refreshed, std::memory_order_relaxed);
+                return;
             }
         }
-        return false;
+        if (isBound) {
+            if (boundSlot) victim = boundSlot;
+        } else if (exactSlot) {
+            victim = exactSlot;
+        } else if (boundSlot && depthOf(boundSlot->data.load(std::memory_order_relaxed)) <= depth) {
+            victim = boundSlot;
+        }
+        if (!victim) return;  // Every other slot holds this board's entries and none may be replaced
+        victim->key.store(board ^ data, std::memory_order_relaxed);
+        victim->data.store(data, std::memory_order_relaxed);
+#if defined(TFE_SEARCH_STATS)
+        counters_.stores.fetch_add(1, std::memory_order_relaxed);
+#endif
     }
 
-    void TranspositionTable::put(const Bitboard board, const int depth, const float score) { table_[board] = {depth, score}; }
+    void TranspositionTable::clear() {
+        for (std::size_t i = 0; i < bucketCount_; ++i) {
+            for (Slot& slot : buckets_[i].slots) {
+                slot.key.store(0, std::memory_order_relaxed);
+                slot.data.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
 
-    void TranspositionTable::clear() { table_.clear(); }
-}  // namespace tfe::core
\ No newline at end of file
+    TranspositionTable::Stats TranspositionTable::stats() const {
+        Stats stats;
+        stats.probes = counters_.probes.load(std::memory_order_relaxed);
+        stats.hits = counters_.hits.load(std::memory_order_relaxed);
+        stats.stores = counters_.stores.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void TranspositionTable::resetStats() {
+        counters_.probes.store(0, std::memory_order_relaxed);
+        counters_.hits.store(0, std::memory_order_relaxed);
+        counters_.stores.store(0, std::memory_order_relaxed);
+    }
+}  // namespace tfe::core
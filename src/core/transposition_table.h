@@ -1,27 +1,138 @@
 #pragma once
-#include <unordered_map>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 
 #include "types.h"
 
 namespace tfe::core {
 
-    struct TTEntry {
-        int depth;
-        float score;
-    };
-
+    /**
+     * @class TranspositionTable
+     * @brief Fixed-size, lock-free cache of chance-node values shared by every search thread.
+     *
+     * The table is preallocated (sized in MB) and never grows. Each 64-byte bucket holds four
+     * 16-byte slots; a board hashes to one bucket, so a probe touches a single cache line.
+     *
+     * Slots are written without locks: the key word stores board ^ data, so a slot torn by two
+     * concurrent writers fails verification on read and is treated as a miss (lockless hashing).
+     * Entries survive between moves: newSearch() starts a new generation instead of wiping the
+     * table, so the subtree the next move revisits after the real spawn is already there. On a
+     * full bucket the entry with the lowest depth - AGE_WEIGHT * age is replaced, i.e. shallow
+     * entries go first and stale ones lose their depth bonus as they age.
+     *
+     * Independent searches (e.g. games played side by side) may share the table: get/put/clear and
+     * newSearch are all atomic. Only resize() needs every search to be stopped. Searches share instance()
+     * unless SearchOptions::table names a table of their own.
+     */
     class TranspositionTable {
     public:
+        static constexpr std::size_t DEFAULT_SIZE_MB = 16;
+
+        // Empty table of @p megabytes (see resize)
+        explicit TranspositionTable(std::size_t megabytes = DEFAULT_SIZE_MB);
+
+        // The table searches use by default
         static TranspositionTable& instance();
 
+        /**
+         * @brief Returns the stored score when the entry was searched exactly @p depth deep. A deeper value would be
+         *        a better estimate, but reading it makes a node's value depend on what else the search visited:
+         *        searches that visit less (Star1 pruning) or in another order (threads) would then pick other moves.
+         */
         bool get(Bitboard board, int depth, float& score) const;
 
         void put(Bitboard board, int depth, float score);
 
+        /**
+         * @brief Upper bounds on chance nodes cut by Star1 pruning, so a transposition is cut without searching.
+         *        A bound is kept in its own slot beside the board's exact entry and never evicts one; get() ignores
+         *        bounds. Like get(), getUpperBound() only answers the depth the bound was searched at. Probes are
+         *        not counted in stats().
+         */
+        bool getUpperBound(Bitboard board, int depth, float& bound) const;
+        void putUpperBound(Bitboard board, int depth, float bound);
+
         void clear();
 
+        /**
+         * @brief Starts a new search generation. Older entries stay readable but become preferred victims.
+         */
+        void newSearch() { generation_.fetch_add(1, std::memory_order_relaxed); }
+
+        /**
+         * @brief Records what the stored values were computed with (evaluator, weights, sampling) and returns the
+         *        previous record, so a search can tell whether the entries it would reuse are on its own scale.
+         */
+        uint64_t exchangeContentTag(const uint64_t tag) { return contentTag_.exchange(tag, std::memory_order_relaxed); }
+
+        struct Stats {
+            uint64_t probes = 0;
+            uint64_t hits = 0;
+            uint64_t stores = 0;
+
+            double hitRate() const { return probes == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(probes); }
+        };
+
+        // Counters since the last resetStats() (relaxed atomics; totals are exact once searches finish).
+        // Only counted in TFE_SEARCH_STATS builds, zero otherwise.
+        Stats stats() const;
+        void resetStats();
+
+        /**
+         * @brief Reallocates the table (contents are dropped). Must not run concurrently with a search.
+         * @param megabytes Memory budget; rounded down to a power-of-two number of 64-byte buckets (at least two).
+         */
+        void resize(std::size_t megabytes);
+
+        std::size_t sizeBytes() const { return bucketCount_ * sizeof(Bucket); }
+        std::size_t configuredMegabytes() const { return megabytes_; }
+        std::size_t capacity() const { return bucketCount_ * SLOTS_PER_BUCKET; }
+
     private:
-        TranspositionTable() = default;
-        std::unordered_map<Bitboard, TTEntry> table_;
+        static constexpr int SLOTS_PER_BUCKET = 4;
+
+        // data layout: bits 0-31 score (float bits), 32-39 depth, 40-47 generation, 62 upper bound, 63 occupied
+        static constexpr uint64_t OCCUPIED = uint64_t{1} << 63;
+        static constexpr uint64_t UPPER_BOUND = uint64_t{1} << 62;
+        static constexpr int AGE_WEIGHT = 8;
+
+        struct Slot {
+            std::atomic<uint64_t> key;   // board ^ data
+            std::atomic<uint64_t> data;
+        };
+
+        struct alignas(64) Bucket {
+            Slot slots[SLOTS_PER_BUCKET];
+        };
+        static_assert(sizeof(Slot) == 16, "transposition table slots must stay 16 bytes");
+        static_assert(sizeof(Bucket) == 64, "a bucket must fill exactly one cache line");
+
+        uint64_t pack(int depth, float score) const;
+        void store(Bitboard board, uint64_t data);
+        // Data word of the slot holding @p board's exact entry (kind 0) or bound (kind UPPER_BOUND), 0 when there is none
+        uint64_t find(Bitboard board, uint64_t kind) const;
+        static int depthOf(const uint64_t data) { return static_cast<int>((data >> 32) & 0xFF); }
+        int ageOf(const uint64_t data) const {
+            return static_cast<uint8_t>(generation_.load(std::memory_order_relaxed) - ((data >> 40) & 0xFF));
+        }
+
+        Bucket& bucketOf(const Bitboard board) const { return buckets_[(board * 0x9E3779B97F4A7C15ULL) >> shift_]; }
+
+        std::unique_ptr<Bucket[]> buckets_;
+        std::size_t bucketCount_ = 0;
+        std::size_t megabytes_ = 0;
+        int shift_ = 64;  // 64 - log2(bucketCount_): the top hash bits pick the bucket
+        std::atomic<uint8_t> generation_{0};
+        std::atomic<uint64_t> contentTag_{0};
+
+        // Kept off the buckets' cache lines
+        struct alignas(64) Counters {
+            std::atomic<uint64_t> probes{0};
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> stores{0};
+        };
+        mutable Counters counters_;
     };
-}  // namespace tfe::core
\ No newline at end of file
+}  // namespace tfe::core
@@ -13,7 +13,8 @@ namespace tfe::game {
      *
      * Initializes the game with a 4x4 board and sets the running state to true.
      */
-    Game::Game() : board_(4), isRunning_(true) {}
+    Game::Game(const tfe::core::SearchOptions& aiOptions, const AutoplayEngine engine)
+        : board_(4), aiOptions_(aiOptions), engine_(engine), isRunning_(true) {}
 
     /**
      * @brief Runs the main game loop for the console version.
@@ -72,14 +73,27 @@ namespace tfe::game {
                 case input::InputHandler::InputCommand::AutoPlay: {
                     // Chạy vòng lặp AI liên tục cho đến khi thua
                     while (!board_.isGameOver() && isRunning_) {
-                        // 1. AI suy nghĩ (Depth 4-6)
-                        auto bestDir = tfe::core::AISolver::findBestMove(board_, 12);
+                        // 1. AI suy nghĩ: depth/time theo độ nguy hiểm của bàn cờ (expectimax) hoặc MCTS trong thời gian cố định
+                        tfe::core::Direction bestDir;
+                        tfe::core::SearchStats stats;
+                        tfe::core::MCTSStats mctsStats;
+                        if (engine_ == AutoplayEngine::Mcts) {
+                            tfe::core::MCTSOptions mctsOptions;
+                            mctsOptions.threads = aiOptions_.threads;
+                            mctsOptions.timeLimitMs = aiOptions_.timeLimitMs;
+                            bestDir = tfe::core::MCTSSolver::findBestMove(board_, mctsOptions, &mctsStats);
+                        } else {
+                            bestDir = tfe::core::AISolver::findBestMove(
+                                board_, tfe::core::AISolver::planSearch(board_, aiOptions_.timeLimitMs), aiOptions_, &stats);
+                        }
 
                         // 2. Thực hiện nước đi
                         bool aiMoved = board_.move(bestDir);
 
                         // 3. Vẽ lại màn hình
                         tfe::renderer::ConsoleRenderer::render(board_);
+                        if (engine_ == AutoplayEngine::Mcts) tfe::renderer::ConsoleRenderer::renderSearchStats(mctsStats);
+                        else tfe::renderer::ConsoleRenderer::renderSearchStats(stats);
 
                         // 4. Ngủ một chút để mắt người kịp nhìn (50ms)
                         // Giảm xuống 0ms nếu muốn xem tốc độ bàn thờ
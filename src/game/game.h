@@ -1,10 +1,15 @@
 #pragma once
+#include "../core/ai_solver.h"
 #include "../core/board.h"
+#include "../core/mcts_solver.h"
 #include "../input/input-handler.h"
 #include "../renderer/console-renderer.h"
 
 namespace tfe::game {
 
+    // Search engine behind autoplay
+    enum class AutoplayEngine { Expectimax, Mcts };
+
     /**
      * @class Game
      * @brief Manages the main game loop and orchestrates the different components for the console version.
@@ -16,8 +21,10 @@ namespace tfe::game {
     public:
         /**
          * @brief Constructs a new Game instance.
+         * @param aiOptions Search settings used by autoplay (e.g. thread count); MCTS takes its threads and time budget.
+         * @param engine Expectimax (AISolver) or Monte Carlo tree search (MCTSSolver).
          */
-        Game();
+        explicit Game(const tfe::core::SearchOptions& aiOptions = {}, AutoplayEngine engine = AutoplayEngine::Expectimax);
 
         /**
          * @brief Starts and runs the main game loop.
@@ -28,6 +35,8 @@ namespace tfe::game {
         tfe::core::Board board_;
         tfe::input::InputHandler inputHandler_;
         tfe::renderer::ConsoleRenderer renderer_;
+        tfe::core::SearchOptions aiOptions_;
+        AutoplayEngine engine_;
         bool isRunning_;
     };
 
@@ -32,7 +32,7 @@ namespace tfe::gui {
 
         static void drawExitDialog() ;
 
-        tfe::core::Board board_;
+        tfe::core::ObservableBoard board_;
         RaylibRenderer renderer_;
         bool isGameOver_;
         tfe::core::Direction currentMoveDirection_;  // To handle transformed coordinates
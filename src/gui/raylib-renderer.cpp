@@ -187,7 +187,7 @@ namespace tfe::gui {
      * @brief Draws the entire game board, including all tiles and animations.
      * @param board The current state of the game board.
      */
-    void RaylibRenderer::draw(const tfe::core::Board& board) const {
+    void RaylibRenderer::draw(const tfe::core::ObservableBoard& board) const {
         ClearBackground(Theme::BG_COLOR);
 
         // --- Draw Header ---
@@ -61,7 +61,7 @@ namespace tfe::gui {
          * @brief Draws the entire game state to the screen.
          * @param board The current state of the game board.
          */
-        void draw(const tfe::core::Board& board) const;
+        void draw(const tfe::core::ObservableBoard& board) const;
 
         /**
          * @brief Updates all ongoing animations based on the elapsed time.
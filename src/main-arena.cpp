@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/lookup_table.h"
+#include "core/mcts_solver.h"
+#include "core/ntuple_network.h"
+#include "core/opening_book.h"
+#include "core/transposition_table.h"
+#include "utils/thread-pool.h"
+
+using json = nlohmann::json;
+using namespace tfe::core;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct ArenaConfig {
+        int games = 100;
+        int jobs = 0;  // 0 = all hardware threads
+        uint64_t seed = 1;
+        std::string solver = "adaptive";
+        int depth = 3;
+        int timeMs = 10;
+        int searchThreads = 1;
+        uint64_t playouts = 0;
+        int sampleSpawns = 0;
+        bool starPruning = false;
+        std::size_t ttMb = 0;
+        std::string weights = "f32";
+        std::string network;
+        std::string book;
+        int maxMoves = 0;  // 0 = play every game to the end
+        std::string jsonPath;
+        std::string label;
+    };
+
+    struct GameResult {
+        uint64_t seed = 0;
+        int score = 0;
+        int maxTile = 0;
+        int moves = 0;
+        double ms = 0;
+    };
+
+    // Nearest-rank percentile of a sorted sample
+    template <typename T>
+    T percentile(const std::vector<T>& sorted, const double p) {
+        if (sorted.empty()) return T{};
+        const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    int maxTileOf(const Bitboard board) {
+        int exponent = 0;
+        for (int i = 0; i < 16; ++i) exponent = std::max(exponent, static_cast<int>((board >> (4 * i)) & 0xF));
+        return exponent == 0 ? 0 : 1 << exponent;
+    }
+
+    void printUsage() {
+        std::cout << "Usage: 2048-arena [--games N] [--jobs N] [--seed S] [--solver expectimax|adaptive|mcts] [--depth D]\n"
+                     "                  [--time-ms T] [--search-threads N] [--playouts N] [--sample-spawns K] [--star-pruning 0|1]\n"
+                     "                  [--tt-mb N] [--weights f32|i16|f16] [--network PATH] [--book PATH] [--max-moves N]\n"
+                     "                  [--json PATH|-] [--label TEXT]\n";
+    }
+
+    bool parseArgs(const int argc, char** argv, ArenaConfig& config) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(arg, "--help") == 0) return false;
+            if (!hasValue) {
+                std::cerr << "[Arena] Error: Missing value for " << arg << "\n";
+                return false;
+            }
+            const char* value = argv[++i];
+            if (std::strcmp(arg, "--games") == 0) config.games = std::atoi(value);
+            else if (std::strcmp(arg, "--jobs") == 0) config.jobs = std::atoi(value);
+            else if (std::strcmp(arg, "--seed") == 0) config.seed = std::strtoull(value, nullptr, 10);
+            else if (std::strcmp(arg, "--solver") == 0) config.solver = value;
+            else if (std::strcmp(arg, "--depth") == 0) config.depth = std::atoi(value);
+            else if (std::strcmp(arg, "--time-ms") == 0) config.timeMs = std::atoi(value);
+            else if (std::strcmp(arg, "--search-threads") == 0) config.searchThreads = std::atoi(value);
+            else if (std::strcmp(arg, "--playouts") == 0) config.playouts = std::strtoull(value, nullptr, 10);
+            else if (std::strcmp(arg, "--sample-spawns") == 0) config.sampleSpawns = std::atoi(value);
+            else if (std::strcmp(arg, "--star-pruning") == 0) config.starPruning = std::atoi(value) != 0;
+            else if (std::strcmp(arg, "--tt-mb") == 0) config.ttMb = static_cast<std::size_t>(std::atoll(value));
+            else if (std::strcmp(arg, "--weights") == 0) config.weights = value;
+            else if (std::strcmp(arg, "--network") == 0) config.network = value;
+            else if (std::strcmp(arg, "--book") == 0) config.book = value;
+            else if (std::strcmp(arg, "--max-moves") == 0) config.maxMoves = std::atoi(value);
+            else if (std::strcmp(arg, "--json") == 0) config.jsonPath = value;
+            else if (std::strcmp(arg, "--label") == 0) config.label = value;
+            else {
+                std::cerr << "[Arena] Error: Unknown option " << arg << "\n";
+                return false;
+            }
+        }
+        if (config.solver != "expectimax" && config.solver != "adaptive" && config.solver != "mcts") {
+            std::cerr << "[Arena] Error: Unknown solver " << config.solver << "\n";
+            return false;
+        }
+        if (config.weights != "f32" && config.weights != "i16" && config.weights != "f16") {
+            std::cerr << "[Arena] Error: Unknown weight precision " << config.weights << "\n";
+            return false;
+        }
+        if (config.solver == "mcts" && config.timeMs <= 0 && config.playouts == 0) {
+            std::cerr << "[Arena] Error: mcts needs --time-ms or --playouts\n";
+            return false;
+        }
+        return config.games > 0;
+    }
+
+    json configJson(const ArenaConfig& config, const int jobs) {
+        return {{"label", config.label},         {"solver", config.solver},   {"games", config.games},
+                {"jobs", jobs},                  {"seed", config.seed},       {"depth", config.depth},
+                {"time_ms", config.timeMs},      {"search_threads", config.searchThreads},
+                {"playouts", config.playouts},   {"sample_spawns", config.sampleSpawns},
+                {"star_pruning", config.starPruning},
+                {"tt_mb", config.ttMb},          {"weights", config.weights}, {"network", config.network},
+                {"book", config.book},           {"max_moves", config.maxMoves}};
+    }
+
+}  // namespace
+
+/**
+ * @brief Headless self-play arena for judging solver changes.
+ *
+ * Plays --games complete games (game i replays seed --seed + i) with one solver configuration,
+ * --jobs games at a time, without rendering or sleeping. Reports the score distribution, how
+ * often each tile was reached, moves per second and the per-move latency, and optionally writes
+ * the whole run (configuration, summary and every game) as JSON so runs can be compared later.
+ *
+ * Every job owns a transposition table of --tt-mb (16 MB by default), so each game sees the table
+ * as it would alone: its entries age once per move of that game and no other game clears them.
+ */
+int main(int argc, char** argv) {
+    ArenaConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        printUsage();
+        return 1;
+    }
+
+    // Load the weight file before any game thread starts (the first Board would otherwise do it mid-run)
+    LookupTable::ensureInitialized();
+    if (config.weights == "i16") LookupTable::setWeightPrecision(WeightPrecision::Int16);
+    else if (config.weights == "f16") LookupTable::setWeightPrecision(WeightPrecision::Float16);
+    NTupleNetwork network({{0}}, false);
+    const bool useNetwork = !config.network.empty();
+    if (useNetwork && !NTupleNetwork::load(config.network.c_str(), network)) return 1;
+    OpeningBook book;
+    if (!config.book.empty() && !book.open(config.book.c_str())) return 1;
+
+    const int jobs = std::min(config.jobs > 0 ? config.jobs : tfe::utils::ThreadPool::hardwareThreads(), config.games);
+
+    SearchOptions searchOptions;
+    searchOptions.threads = config.searchThreads;
+    searchOptions.sampleSpawns = config.sampleSpawns;
+    searchOptions.starPruning = config.starPruning;
+    searchOptions.evaluator = useNetwork ? &network : nullptr;
+    searchOptions.book = book.isOpen() ? &book : nullptr;
+
+    // One move of the configured solver; @p options carries the job's own table
+    std::atomic<uint64_t> bookHits{0};
+    const auto search = [&](const Board& board, const SearchLimits& limits, const SearchOptions& options) {
+        if (!options.book) return AISolver::findBestMove(board, limits, options);
+        SearchStats stats;
+        const Direction dir = AISolver::findBestMove(board, limits, options, &stats);
+        if (stats.bookHit) bookHits.fetch_add(1, std::memory_order_relaxed);
+        return dir;
+    };
+    const auto chooseMove = [&](const Board& board, const uint64_t seed, const SearchOptions& options) {
+        if (config.solver == "mcts") {
+            MCTSOptions options;
+            options.threads = config.searchThreads;
+            options.timeLimitMs = config.timeMs;
+            options.maxPlayouts = config.playouts;
+            options.seed = seed;
+            return MCTSSolver::findBestMove(board, options);
+        }
+        if (config.solver == "adaptive") return search(board, AISolver::planSearch(board, config.timeMs), options);
+        return search(board, SearchLimits::withTimeBudget(config.timeMs, config.depth), options);
+    };
+
+    std::vector<GameResult> results(static_cast<std::size_t>(config.games));
+    std::vector<std::vector<double>> moveMs(static_cast<std::size_t>(jobs));
+    std::atomic<int> nextGame{0};
+    std::atomic<int> finished{0};
+    std::mutex printMutex;
+
+    const auto start = Clock::now();
+    const auto worker = [&](const int job) {
+        std::vector<double>& latencies = moveMs[static_cast<std::size_t>(job)];
+        // MCTS keeps no table, so it does not pay for one
+        std::unique_ptr<TranspositionTable> table;
+        SearchOptions options = searchOptions;
+        if (config.solver != "mcts") {
+            table = std::make_unique<TranspositionTable>(config.ttMb != 0 ? config.ttMb : TranspositionTable::DEFAULT_SIZE_MB);
+            options.table = table.get();
+        }
+        for (int g = nextGame.fetch_add(1); g < config.games; g = nextGame.fetch_add(1)) {
+            GameResult& result = results[static_cast<std::size_t>(g)];
+            result.seed = config.seed + static_cast<uint64_t>(g);
+            Board board(4, result.seed);
+            const auto gameStart = Clock::now();
+            while (!board.isGameOver() && (config.maxMoves == 0 || result.moves < config.maxMoves)) {
+                const auto moveStart = Clock::now();
+                const Direction dir = chooseMove(board, result.seed * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(result.moves) + 1, options);
+                latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - moveStart).count());
+                if (!board.move(dir)) break;  // Should not happen: every solver returns a legal move
+                ++result.moves;
+            }
+            result.ms = std::chrono::duration<double, std::milli>(Clock::now() - gameStart).count();
+            result.score = board.getScore();
+            result.maxTile = maxTileOf(board.getState().board);
+
+            const std::lock_guard lock(printMutex);
+            std::fprintf(stderr, "[%d/%d] seed %llu: score %d, max tile %d, %d moves\n", finished.fetch_add(1) + 1, config.games,
+                         static_cast<unsigned long long>(result.seed), result.score, result.maxTile, result.moves);
+        }
+    };
+    {
+        std::vector<std::thread> threads;
+        for (int job = 1; job < jobs; ++job) threads.emplace_back(worker, job);
+        worker(0);
+        for (std::thread& thread : threads) thread.join();
+    }
+    const double wallSec = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Summary
+    std::vector<int> scores;
+    long long totalMoves = 0;
+    for (const GameResult& r : results) {
+        scores.push_back(r.score);
+        totalMoves += r.moves;
+    }
+    std::sort(scores.begin(), scores.end());
+    double mean = 0;
+    for (const int s : scores) mean += s;
+    mean /= static_cast<double>(scores.size());
+
+    std::vector<double> latencies;
+    for (const auto& job : moveMs) latencies.insert(latencies.end(), job.begin(), job.end());
+    std::sort(latencies.begin(), latencies.end());
+    const double meanMs = latencies.empty() ? 0.0 : std::accumulate(latencies.begin(), latencies.end(), 0.0) / static_cast<double>(latencies.size());
+
+    json reach = json::object();
+    for (int tile = 512; tile <= 32768; tile *= 2) {
+        const auto count = std::count_if(results.begin(), results.end(), [&](const GameResult& r) { return r.maxTile >= tile; });
+        reach[std::to_string(tile)] = static_cast<double>(count) / static_cast<double>(results.size());
+    }
+
+    const json summary = {
+        {"score", {{"mean", mean},
+                   {"median", percentile(scores, 50)},
+                   {"p10", percentile(scores, 10)},
+                   {"p25", percentile(scores, 25)},
+                   {"p75", percentile(scores, 75)},
+                   {"p90", percentile(scores, 90)},
+                   {"min", scores.front()},
+                   {"max", scores.back()}}},
+        {"max_tile_reach", reach},
+        {"moves", totalMoves},
+        {"wall_seconds", wallSec},
+        {"moves_per_second", static_cast<double>(totalMoves) / wallSec},
+        {"book_hits", bookHits.load()},
+        {"ms_per_move", {{"mean", meanMs},
+                         {"p50", percentile(latencies, 50)},
+                         {"p99", percentile(latencies, 99)},
+                         {"max", latencies.empty() ? 0.0 : latencies.back()}}},
+    };
+
+    // The text summary moves to stderr when the JSON report goes to stdout
+    FILE* out = config.jsonPath == "-" ? stderr : stdout;
+    std::fprintf(out, "%s: %d games, %d jobs, %.1f s\n", config.solver.c_str(), config.games, jobs, wallSec);
+    std::fprintf(out, "score   mean %.0f  median %d  p10 %d  p90 %d  min %d  max %d\n", mean, percentile(scores, 50), percentile(scores, 10),
+                 percentile(scores, 90), scores.front(), scores.back());
+    std::fprintf(out, "reach  ");
+    for (int tile = 512; tile <= 32768; tile *= 2) std::fprintf(out, " %d: %.0f%%", tile, 100.0 * reach[std::to_string(tile)].get<double>());
+    std::fprintf(out, "\nspeed   %.0f moves/s   ms/move mean %.2f  p50 %.2f  p99 %.2f  max %.2f\n", static_cast<double>(totalMoves) / wallSec, meanMs,
+                 percentile(latencies, 50), percentile(latencies, 99), latencies.empty() ? 0.0 : latencies.back());
+    if (!config.book.empty()) {
+        std::fprintf(out, "book    %llu hits (%.1f%% of moves)\n", static_cast<unsigned long long>(bookHits.load()),
+                     totalMoves == 0 ? 0.0 : 100.0 * static_cast<double>(bookHits.load()) / static_cast<double>(totalMoves));
+    }
+
+    if (!config.jsonPath.empty()) {
+        json report = {{"config", configJson(config, jobs)}, {"summary", summary}, {"games", json::array()}};
+        for (const GameResult& r : results) {
+            report["games"].push_back({{"seed", r.seed}, {"score", r.score}, {"max_tile", r.maxTile}, {"moves", r.moves}, {"ms", r.ms}});
+        }
+        if (config.jsonPath == "-") {
+            std::cout << report.dump(2) << "\n";
+        } else if (std::ofstream file(config.jsonPath); file.is_open()) {
+            file << report.dump(2) << "\n";
+        } else {
+            std::cerr << "[Arena] Error: Could not write " << config.jsonPath << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ai_solver.h"
+#include "core/lookup_table.h"
+#include "core/opening_book.h"
+#include "core/transposition_table.h"
+#include "utils/thread-pool.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct BookConfig {
+        std::string out = "opening_book.bin";
+        int games = 2000;
+        int plies = 40;  // Opening moves of each game that are counted
+        int playDepth = 2;
+        std::size_t positions = 100000;
+        uint32_t minCount = 2;
+        int depth = 5;
+        int jobs = 0;  // 0 = all hardware threads
+        uint64_t seed = 1;
+        std::size_t ttMb = 0;
+    };
+
+    void printUsage() {
+        std::cout << "Usage: 2048-book [--out PATH] [--games N] [--plies N] [--play-depth D] [--positions N] [--min-count N]\n"
+                     "                 [--depth D] [--jobs N] [--seed S] [--tt-mb N]\n";
+    }
+
+    bool parseArgs(const int argc, char** argv, BookConfig& config) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strcmp(arg, "--help") == 0) return false;
+            if (i + 1 >= argc) {
+                std::cerr << "[Book] Error: Missing value for " << arg << "\n";
+                return false;
+            }
+            const char* value = argv[++i];
+            if (std::strcmp(arg, "--out") == 0) config.out = value;
+            else if (std::strcmp(arg, "--games") == 0) config.games = std::atoi(value);
+            else if (std::strcmp(arg, "--plies") == 0) config.plies = std::atoi(value);
+            else if (std::strcmp(arg, "--play-depth") == 0) config.playDepth = std::atoi(value);
+            else if (std::strcmp(arg, "--positions") == 0) config.positions = static_cast<std::size_t>(std::atoll(value));
+            else if (std::strcmp(arg, "--min-count") == 0) config.minCount = static_cast<uint32_t>(std::atoi(value));
+            else if (std::strcmp(arg, "--depth") == 0) config.depth = std::atoi(value);
+            else if (std::strcmp(arg, "--jobs") == 0) config.jobs = std::atoi(value);
+            else if (std::strcmp(arg, "--seed") == 0) config.seed = std::strtoull(value, nullptr, 10);
+            else if (std::strcmp(arg, "--tt-mb") == 0) config.ttMb = static_cast<std::size_t>(std::atoll(value));
+            else {
+                std::cerr << "[Book] Error: Unknown option " << arg << "\n";
+                return false;
+            }
+        }
+        return config.games > 0 && config.plies > 0 && config.positions > 0 && config.depth > 0;
+    }
+
+    // Runs fn(job) on @p jobs threads, the calling thread being job 0
+    template <typename F>
+    void runJobs(const int jobs, F&& fn) {
+        std::vector<std::thread> threads;
+        for (int job = 1; job < jobs; ++job) threads.emplace_back(fn, job);
+        fn(0);
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    double secondsSince(const Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+}  // namespace
+
+/**
+ * @brief Builds an opening book for SearchOptions::book.
+ *
+ * 1. Plays --games seeded games with a fast --play-depth search and counts the canonical positions of
+ *    their first --plies moves.
+ * 2. Keeps the --positions most frequent ones seen at least --min-count times.
+ * 3. Searches each of them to --depth (no deadline), --jobs positions at a time, and writes the book.
+ *
+ * Reports how many of the counted opening positions the book covers and the throughput of each phase.
+ */
+int main(int argc, char** argv) {
+    BookConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        printUsage();
+        return 1;
+    }
+    LookupTable::ensureInitialized();
+    if (config.ttMb != 0) TranspositionTable::instance().resize(config.ttMb);
+    const int jobs = config.jobs > 0 ? config.jobs : tfe::utils::ThreadPool::hardwareThreads();
+
+    // 1. Count opening positions
+    auto start = Clock::now();
+    std::vector<std::unordered_map<Bitboard, uint32_t>> counts(static_cast<std::size_t>(jobs));
+    std::atomic<int> nextGame{0};
+    runJobs(jobs, [&](const int job) {
+        auto& seen = counts[static_cast<std::size_t>(job)];
+        SearchOptions options;
+        options.timeLimitMs = 0;
+        for (int g = nextGame.fetch_add(1); g < config.games; g = nextGame.fetch_add(1)) {
+            Board board(4, config.seed + static_cast<uint64_t>(g));
+            for (int ply = 0; ply < config.plies && !board.isGameOver(); ++ply) {
+                ++seen[canonicalBoard(board.getState().board)];
+                board.move(AISolver::findBestMove(board, config.playDepth, options));
+            }
+        }
+    });
+    std::unordered_map<Bitboard, uint32_t> merged = std::move(counts[0]);
+    for (std::size_t job = 1; job < counts.size(); ++job) {
+        for (const auto& [board, count] : counts[job]) merged[board] += count;
+    }
+    const double countSec = secondsSince(start);
+
+    // 2. Most frequent positions first
+    std::vector<std::pair<uint32_t, Bitboard>> ranked;
+    uint64_t visits = 0;
+    for (const auto& [board, count] : merged) {
+        visits += count;
+        if (count >= config.minCount) ranked.emplace_back(count, board);
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+    if (ranked.size() > config.positions) ranked.resize(config.positions);
+    uint64_t covered = 0;
+    for (const auto& [count, board] : ranked) covered += count;
+
+    // 3. Deep search of every kept position
+    start = Clock::now();
+    std::vector<OpeningBook::Entry> entries(ranked.size());
+    std::atomic<std::size_t> nextPosition{0};
+    std::atomic<std::size_t> searched{0};
+    std::mutex printMutex;
+    runJobs(jobs, [&](int) {
+        SearchLimits limits;
+        limits.maxDepth = config.depth;
+        for (std::size_t i = nextPosition.fetch_add(1); i < ranked.size(); i = nextPosition.fetch_add(1)) {
+            Board board(4, 1);
+            board.loadState({ranked[i].second, 0});
+            entries[i] = {ranked[i].second, AISolver::findBestMove(board, limits)};
+            if (const std::size_t done = searched.fetch_add(1) + 1; done % 1000 == 0) {
+                const std::lock_guard lock(printMutex);
+                std::fprintf(stderr, "[%zu/%zu] positions searched\n", done, ranked.size());
+            }
+        }
+    });
+    const double searchSec = secondsSince(start);
+
+    start = Clock::now();
+    const std::size_t written = OpeningBook::write(config.out.c_str(), entries);
+    const double writeSec = secondsSince(start);
+    if (written == 0 && !entries.empty()) {
+        std::cerr << "[Book] Error: Could not write " << config.out << "\n";
+        return 1;
+    }
+
+    std::printf("count   %d games, %llu positions (%zu distinct) in %.1f s\n", config.games, static_cast<unsigned long long>(visits),
+                merged.size(), countSec);
+    std::printf("search  %zu positions at depth %d in %.1f s (%.1f positions/s, %d jobs)\n", ranked.size(), config.depth, searchSec,
+                static_cast<double>(ranked.size()) / std::max(searchSec, 1e-9), jobs);
+    std::printf("book    %s: %zu positions, %llu bytes, written in %.3f s\n", config.out.c_str(), written,
+                static_cast<unsigned long long>(std::filesystem::file_size(config.out)), writeSec);
+    std::printf("cover   %.1f%% of the counted opening positions\n", visits == 0 ? 0.0 : 100.0 * static_cast<double>(covered) / static_cast<double>(visits));
+    return 0;
+}
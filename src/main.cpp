@@ -1,3 +1,9 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "core/lookup_table.h"
+#include "core/opening_book.h"
 #include "game/game.h"
 
 /**
@@ -5,9 +11,52 @@
  *
  * This function creates an instance of the `Game` class and calls its `run` method
  * to start the main game loop.
+ *
+ * Options:
+ *   --threads N   Threads used by the autoplay search (0 = all hardware threads, default 1).
+ *   --tt-mb N     Transposition table size in MB (default 16).
+ *   --symmetric   Share transposition entries between rotated/reflected boards.
+ *   --star        Star1 pruning of chance nodes (fewer nodes, same moves; single-threaded search only).
+ *   --weights P   Heuristic table encoding: f32 (default), i16 or f16 (half the cache footprint).
+ *   --engine E    Autoplay engine: expectimax (default) or mcts.
+ *   --book P      Opening book (built by 2048-book) answering known positions without searching.
+ *
+ * An unknown --weights or --engine value prints the accepted ones and exits with status 1.
  */
-int main() {
-    tfe::game::Game game;
+int main(int argc, char** argv) {
+    tfe::core::SearchOptions aiOptions;
+    auto engine = tfe::game::AutoplayEngine::Expectimax;
+    tfe::core::OpeningBook book;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            aiOptions.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--tt-mb") == 0 && i + 1 < argc) {
+            aiOptions.ttSizeMb = static_cast<std::size_t>(std::atoll(argv[++i]));
+        } else if (std::strcmp(argv[i], "--symmetric") == 0) {
+            aiOptions.symmetricKeys = true;
+        } else if (std::strcmp(argv[i], "--star") == 0) {
+            aiOptions.starPruning = true;
+        } else if (std::strcmp(argv[i], "--weights") == 0 && i + 1 < argc) {
+            const char* precision = argv[++i];
+            if (std::strcmp(precision, "i16") == 0) tfe::core::LookupTable::setWeightPrecision(tfe::core::WeightPrecision::Int16);
+            else if (std::strcmp(precision, "f16") == 0) tfe::core::LookupTable::setWeightPrecision(tfe::core::WeightPrecision::Float16);
+            else if (std::strcmp(precision, "f32") != 0) {
+                std::cerr << "Error: Unknown weight precision " << precision << " (expected f32, i16 or f16)\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "mcts") == 0) engine = tfe::game::AutoplayEngine::Mcts;
+            else if (std::strcmp(name, "expectimax") != 0) {
+                std::cerr << "Error: Unknown engine " << name << " (expected expectimax or mcts)\n";
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--book") == 0 && i + 1 < argc) {
+            if (book.open(argv[++i])) aiOptions.book = &book;
+        }
+    }
+
+    tfe::game::Game game(aiOptions, engine);
     game.run();
     return 0;
-}
\ No newline at end of file
+}
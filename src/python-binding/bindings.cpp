@@ -1,6 +1,16 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h> // Automatically convert std::vector to Python List
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include "../core/ai_solver.h"
 #include "../core/board.h"
+#include "../core/lookup_table.h"
+#include "../core/mcts_solver.h"
+#include "../core/sized_board.h"
+#include "../core/move_kernel.h"
+#include "../core/ntuple_network.h"
+#include "../core/opening_book.h"
 
 namespace py = pybind11;
 
@@ -14,19 +24,79 @@ void init_enums(const py::module_& m) {
         .export_values();
 }
 
+// Board3 / Board4 / Board5 / Board6: headless N x N games with size-specialized kernels.
+// get_state() is one int for 3x3/4x4 and a list of 64-bit words (row-packed) for 5x5/6x6.
+template <int N>
+void init_sized_board(py::module_& m, const char* name) {
+    using SizedBoard = tfe::core::SizedBoard<N>;
+    py::class_<SizedBoard>(m, name)
+        .def(py::init([](const std::optional<uint64_t> seed) {
+            return seed ? SizedBoard(*seed) : SizedBoard();
+        }), py::arg("seed") = py::none())
+        .def_property_readonly_static("size", [](const py::object&) { return N; })
+        .def("seed", &SizedBoard::seed, py::arg("seed"))
+        .def("reset", &SizedBoard::reset)
+        .def("move", &SizedBoard::move)
+        .def("is_game_over", &SizedBoard::isGameOver)
+        .def("legal_moves", &SizedBoard::legalMoves)
+        .def("get_score", &SizedBoard::getScore)
+        .def("get_grid", &SizedBoard::getGrid)
+        .def("get_state", &SizedBoard::getState)
+        .def("set_state", &SizedBoard::loadState, py::arg("board"), py::arg("score"));
+
+    m.def("find_best_move",
+          [](const SizedBoard& board, const int depth, const int timeLimitMs, const uint64_t maxNodes) {
+              tfe::core::SearchLimits limits = tfe::core::SearchLimits::withTimeBudget(timeLimitMs, depth);
+              limits.maxNodes = maxNodes;
+              py::gil_scoped_release release;
+              return tfe::core::AISolver::findBestMove(board, limits);
+          },
+          py::arg("board"), py::arg("depth") = 3, py::arg("time_limit_ms") = 200, py::arg("max_nodes") = 0);
+}
+
 PYBIND11_MODULE(py2048, m) {
     m.doc() = "2048 Core C++ Optimized using Bitboard for AI Training";
 
     init_enums(m);
 
+    // All four afterstates in one call: ([up, down, left, right], [rewards...], legal_mask).
+    // Afterstates are boards after sliding, before the random spawn.
+    m.def("compute_moves", [](const uint64_t board) {
+        const tfe::core::MoveSet moves = tfe::core::computeMoves(board);
+        return py::make_tuple(
+            std::vector<uint64_t>(std::begin(moves.after), std::end(moves.after)),
+            std::vector<int>(std::begin(moves.reward), std::end(moves.reward)),
+            moves.legal);
+    });
+
+    // Heuristic table encoding read by the solver's leaf evaluation; never change it while a search runs
+    py::enum_<tfe::core::WeightPrecision>(m, "WeightPrecision")
+        .value("Float32", tfe::core::WeightPrecision::Float32)
+        .value("Int16", tfe::core::WeightPrecision::Int16)
+        .value("Float16", tfe::core::WeightPrecision::Float16);
+    m.def("set_weight_precision", &tfe::core::LookupTable::setWeightPrecision, py::arg("precision"));
+    m.def("load_weights", [](const std::string& path, const tfe::core::WeightPrecision precision) {
+              return tfe::core::LookupTable::loadWeights(path.c_str(), precision);
+          },
+          py::arg("path"), py::arg("precision") = tfe::core::WeightPrecision::Float32);
+
+    // Legal-move mask only (SWAR, no table lookups): bit d set when direction d is legal.
+    m.def("legal_moves", &tfe::core::legalMoves);
+
     py::class_<tfe::core::Board>(m, "Board")
-        .def(py::init<>()) // Default constructor
+        // Board() seeds from the OS; Board(seed) replays identical spawns for identical moves
+        .def(py::init([](const std::optional<uint64_t> seed) {
+            return seed ? tfe::core::Board(4, *seed) : tfe::core::Board();
+        }), py::arg("seed") = py::none())
+        .def("seed", &tfe::core::Board::seed, py::arg("seed"))
         .def("reset", &tfe::core::Board::reset)
         
         // Move function, returns true if board changed
         .def("move", &tfe::core::Board::move)
         
-        .def("is_game_over", &tfe::core::Board::isGameOver)
+        .def("is_game_over", [](const tfe::core::Board& b) { return b.legalMoves() == 0; })
+        // Bit d set when Direction d is legal (Up=1, Down=2, Left=4, Right=8)
+        .def("legal_moves", &tfe::core::Board::legalMoves)
         .def("get_score", &tfe::core::Board::getScore)
         
         // Return Grid (List[List[int]]) for UI rendering or debugging
@@ -46,4 +116,153 @@ PYBIND11_MODULE(py2048, m) {
             state.score = score;
             b.loadState(state);
         });
-}
\ No newline at end of file
+
+    py::class_<tfe::core::SearchStats::Iteration>(m, "SearchIteration")
+        .def_readonly("depth", &tfe::core::SearchStats::Iteration::depth)
+        .def_readonly("nodes", &tfe::core::SearchStats::Iteration::nodes)
+        .def_readonly("ms", &tfe::core::SearchStats::Iteration::ms)
+        .def_readonly("completed", &tfe::core::SearchStats::Iteration::completed);
+
+    // Node breakdown and table counters are 0 in builds without TFE_SEARCH_STATS
+    py::class_<tfe::core::SearchStats>(m, "SearchStats")
+        .def_readonly("iterations", &tfe::core::SearchStats::iterations)
+        .def_readonly("depth_reached", &tfe::core::SearchStats::depthReached)
+        .def_readonly("aborted", &tfe::core::SearchStats::aborted)
+        .def_readonly("total_ms", &tfe::core::SearchStats::totalMs)
+        .def_readonly("book_hit", &tfe::core::SearchStats::bookHit)
+        .def_readonly("nodes", &tfe::core::SearchStats::nodes)
+        .def_readonly("chance_nodes", &tfe::core::SearchStats::chanceNodes)
+        .def_readonly("max_nodes", &tfe::core::SearchStats::maxNodes)
+        .def_readonly("prob_cutoffs", &tfe::core::SearchStats::probCutoffs)
+        .def_readonly("star_cutoffs", &tfe::core::SearchStats::starCutoffs)
+        .def_readonly("tt_probes", &tfe::core::SearchStats::ttProbes)
+        .def_readonly("tt_hits", &tfe::core::SearchStats::ttHits)
+        .def_readonly("tt_stores", &tfe::core::SearchStats::ttStores)
+        .def_readonly("tt_bytes", &tfe::core::SearchStats::ttBytes)
+        .def_property_readonly("tt_hit_rate", &tfe::core::SearchStats::ttHitRate);
+
+    // Learned evaluator for find_best_move(evaluator=...); load() raises on a missing or malformed file
+    py::class_<tfe::core::NTupleNetwork>(m, "NTupleNetwork")
+        .def(py::init<const std::vector<tfe::core::NTupleNetwork::Tuple>&, bool>(), py::arg("tuples"), py::arg("symmetric") = true)
+        .def_static("standard_tuples", &tfe::core::NTupleNetwork::standardTuples)
+        .def_static("load", [](const std::string& path) {
+            tfe::core::NTupleNetwork network({{0}}, false);
+            if (!tfe::core::NTupleNetwork::load(path.c_str(), network)) throw std::runtime_error("Cannot load n-tuple network: " + path);
+            return network;
+        })
+        .def("save", [](const tfe::core::NTupleNetwork& network, const std::string& path) { return network.save(path.c_str()); })
+        .def("evaluate", [](const tfe::core::NTupleNetwork& network, const tfe::core::Board& board) { return network.evaluate(board.getState().board); })
+        .def("update", [](tfe::core::NTupleNetwork& network, const tfe::core::Board& board, const float delta) { network.update(board.getState().board, delta); })
+        .def_property_readonly("tuple_count", &tfe::core::NTupleNetwork::tupleCount)
+        .def_property_readonly("size_bytes", &tfe::core::NTupleNetwork::sizeBytes);
+
+    // Precomputed moves for find_best_move(book=...); open() raises on a missing or malformed file
+    py::class_<tfe::core::OpeningBook>(m, "OpeningBook")
+        .def(py::init<>())
+        .def("open", [](tfe::core::OpeningBook& book, const std::string& path) {
+            if (!book.open(path.c_str())) throw std::runtime_error("Cannot open opening book: " + path);
+        })
+        .def("close", &tfe::core::OpeningBook::close)
+        .def("probe", [](const tfe::core::OpeningBook& book, const tfe::core::Board& board) { return book.probe(board.getState().board); })
+        .def_property_readonly("is_open", &tfe::core::OpeningBook::isOpen)
+        .def("__len__", &tfe::core::OpeningBook::size);
+
+    // threads: 1 = calling thread only, 0 = all hardware threads; time_limit_ms: hard per-move deadline (0 = full depth);
+    // max_nodes: node budget (0 = unlimited); tt_mb: transposition table size in MB (0 keeps the current size);
+    // symmetric_keys: share transposition entries between rotated/reflected boards;
+    // adaptive: depth, cutoff and time from AISolver::planSearch (depth is ignored, time_limit_ms is the typical move);
+    // sample_spawns/sample_seed: sparse chance nodes (0 = exact); skip_fours_below: search only 2 spawns below this probability;
+    // evaluator: NTupleNetwork used at the leaves (None = built-in heuristic); book: OpeningBook probed before searching;
+    // star_pruning: Star1 cuts of chance nodes (fewer nodes, same decisions; threads = 1, built-in heuristic only)
+    const auto search = [](const tfe::core::Board& board, const int depth, const int threads, const int timeLimitMs, const std::size_t ttMb,
+                           const bool symmetricKeys, const uint64_t maxNodes, const bool adaptive, const int sampleSpawns, const uint64_t sampleSeed,
+                           const float skipFoursBelow, const tfe::core::NTupleNetwork* evaluator, const tfe::core::OpeningBook* book,
+                           const bool starPruning, tfe::core::SearchStats* stats) {
+        tfe::core::SearchLimits limits = adaptive ? tfe::core::AISolver::planSearch(board, timeLimitMs)
+                                                  : tfe::core::SearchLimits::withTimeBudget(timeLimitMs, depth);
+        limits.maxNodes = maxNodes;
+        tfe::core::SearchOptions options;
+        options.threads = threads;
+        options.ttSizeMb = ttMb;
+        options.symmetricKeys = symmetricKeys;
+        options.sampleSpawns = sampleSpawns;
+        options.sampleSeed = sampleSeed;
+        options.skipFoursBelowProb = skipFoursBelow;
+        options.evaluator = evaluator;
+        options.book = book;
+        options.starPruning = starPruning;
+        py::gil_scoped_release release;
+        return tfe::core::AISolver::findBestMove(board, limits, options, stats);
+    };
+
+    m.def("find_best_move", [search](const tfe::core::Board& board, const int depth, const int threads, const int timeLimitMs, const std::size_t ttMb,
+                                     const bool symmetricKeys, const uint64_t maxNodes, const bool adaptive, const int sampleSpawns,
+                                     const uint64_t sampleSeed, const float skipFoursBelow, const tfe::core::NTupleNetwork* evaluator,
+                                     const tfe::core::OpeningBook* book, const bool starPruning) {
+              return search(board, depth, threads, timeLimitMs, ttMb, symmetricKeys, maxNodes, adaptive, sampleSpawns, sampleSeed, skipFoursBelow,
+                            evaluator, book, starPruning, nullptr);
+          },
+          py::arg("board"), py::arg("depth") = 4, py::arg("threads") = 1, py::arg("time_limit_ms") = 200, py::arg("tt_mb") = 0,
+          py::arg("symmetric_keys") = false, py::arg("max_nodes") = 0, py::arg("adaptive") = false, py::arg("sample_spawns") = 0,
+          py::arg("sample_seed") = 0, py::arg("skip_fours_below") = 0.0f, py::arg("evaluator") = nullptr, py::arg("book") = nullptr,
+          py::arg("star_pruning") = false);
+
+    // Same arguments as find_best_move; returns (direction, SearchStats)
+    m.def("find_best_move_with_stats", [search](const tfe::core::Board& board, const int depth, const int threads, const int timeLimitMs,
+                                                const std::size_t ttMb, const bool symmetricKeys, const uint64_t maxNodes, const bool adaptive,
+                                                const int sampleSpawns, const uint64_t sampleSeed, const float skipFoursBelow,
+                                                const tfe::core::NTupleNetwork* evaluator, const tfe::core::OpeningBook* book, const bool starPruning) {
+              tfe::core::SearchStats stats;
+              const tfe::core::Direction dir = search(board, depth, threads, timeLimitMs, ttMb, symmetricKeys, maxNodes, adaptive, sampleSpawns,
+                                                      sampleSeed, skipFoursBelow, evaluator, book, starPruning, &stats);
+              return py::make_tuple(dir, stats);
+          },
+          py::arg("board"), py::arg("depth") = 4, py::arg("threads") = 1, py::arg("time_limit_ms") = 200, py::arg("tt_mb") = 0,
+          py::arg("symmetric_keys") = false, py::arg("max_nodes") = 0, py::arg("adaptive") = false, py::arg("sample_spawns") = 0,
+          py::arg("sample_seed") = 0, py::arg("skip_fours_below") = 0.0f, py::arg("evaluator") = nullptr, py::arg("book") = nullptr,
+          py::arg("star_pruning") = false);
+
+    py::class_<tfe::core::MCTSStats>(m, "MCTSStats")
+        .def_readonly("playouts", &tfe::core::MCTSStats::playouts)
+        .def_readonly("nodes", &tfe::core::MCTSStats::nodes)
+        .def_readonly("total_ms", &tfe::core::MCTSStats::totalMs)
+        .def_property_readonly("root_visits", [](const tfe::core::MCTSStats& s) { return std::vector<uint64_t>(s.rootVisits, s.rootVisits + 4); })
+        .def_property_readonly("root_value", [](const tfe::core::MCTSStats& s) { return std::vector<double>(s.rootValue, s.rootValue + 4); });
+
+    // Monte Carlo tree search engine (root parallelization over `threads` trees).
+    // time_limit_ms / max_playouts: whichever runs out first (0 = unused); seed 0 draws a random seed
+    const auto mcts = [](const tfe::core::Board& board, const int threads, const int timeLimitMs, const uint64_t maxPlayouts, const float exploration,
+                         const int maxRolloutMoves, const uint64_t seed, tfe::core::MCTSStats* stats) {
+        tfe::core::MCTSOptions options;
+        options.threads = threads;
+        options.timeLimitMs = timeLimitMs;
+        options.maxPlayouts = maxPlayouts;
+        options.exploration = exploration;
+        options.maxRolloutMoves = maxRolloutMoves;
+        options.seed = seed;
+        py::gil_scoped_release release;
+        return tfe::core::MCTSSolver::findBestMove(board, options, stats);
+    };
+
+    m.def("mcts_find_best_move", [mcts](const tfe::core::Board& board, const int threads, const int timeLimitMs, const uint64_t maxPlayouts,
+                                        const float exploration, const int maxRolloutMoves, const uint64_t seed) {
+              return mcts(board, threads, timeLimitMs, maxPlayouts, exploration, maxRolloutMoves, seed, nullptr);
+          },
+          py::arg("board"), py::arg("threads") = 1, py::arg("time_limit_ms") = 200, py::arg("max_playouts") = 0, py::arg("exploration") = 2.0f,
+          py::arg("max_rollout_moves") = 0, py::arg("seed") = 0);
+
+    // Same arguments as mcts_find_best_move; returns (direction, MCTSStats)
+    m.def("mcts_find_best_move_with_stats", [mcts](const tfe::core::Board& board, const int threads, const int timeLimitMs, const uint64_t maxPlayouts,
+                                                   const float exploration, const int maxRolloutMoves, const uint64_t seed) {
+              tfe::core::MCTSStats stats;
+              const tfe::core::Direction dir = mcts(board, threads, timeLimitMs, maxPlayouts, exploration, maxRolloutMoves, seed, &stats);
+              return py::make_tuple(dir, stats);
+          },
+          py::arg("board"), py::arg("threads") = 1, py::arg("time_limit_ms") = 200, py::arg("max_playouts") = 0, py::arg("exploration") = 2.0f,
+          py::arg("max_rollout_moves") = 0, py::arg("seed") = 0);
+
+    init_sized_board<3>(m, "Board3");
+    init_sized_board<4>(m, "Board4");
+    init_sized_board<5>(m, "Board5");
+    init_sized_board<6>(m, "Board6");
+}
@@ -145,6 +145,30 @@ namespace tfe::renderer {
         std::cout << "Controls: WASD or Arrows to move. Q to Quit.\n";
     }
 
+    /**
+     * @brief Prints the AI status line: depth reached, nodes, time and transposition table usage.
+     * @param stats Statistics of the search that picked the last move.
+     */
+    void ConsoleRenderer::renderSearchStats(const tfe::core::SearchStats& stats) {
+        std::stringstream line;
+        if (stats.bookHit) {
+            line << std::fixed << std::setprecision(3) << "AI: opening book   |   " << stats.totalMs << " ms";
+            std::cout << line.str() << "\n";
+            return;
+        }
+        line << std::fixed << std::setprecision(1) << "AI: depth " << stats.depthReached << (stats.aborted ? "+" : "")
+             << "   |   nodes " << stats.nodes << "   |   " << stats.totalMs << " ms"
+             << "   |   TT hit " << 100.0 * stats.ttHitRate() << "% of " << (stats.ttBytes >> 20) << " MB";
+        std::cout << line.str() << "\n";
+    }
+
+    void ConsoleRenderer::renderSearchStats(const tfe::core::MCTSStats& stats) {
+        std::stringstream line;
+        line << std::fixed << std::setprecision(1) << "AI (MCTS): playouts " << stats.playouts << "   |   nodes " << stats.nodes << "   |   "
+             << stats.totalMs << " ms";
+        std::cout << line.str() << "\n";
+    }
+
     /**
      * @brief Displays a "Game Over" message in bold red text.
      */
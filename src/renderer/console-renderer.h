@@ -1,5 +1,7 @@
 #pragma once
+#include "../core/ai_solver.h"
 #include "../core/board.h"
+#include "../core/mcts_solver.h"
 
 namespace tfe::renderer {
 
@@ -12,6 +14,10 @@ namespace tfe::renderer {
         // Clears the console screen.
         static void clear();
 
+        // Prints a one-line summary of the last AI search below the board (autoplay).
+        static void renderSearchStats(const tfe::core::SearchStats& stats);
+        static void renderSearchStats(const tfe::core::MCTSStats& stats);
+
         // Displays the "Game Over" message on the console.
         static void showGameOver();
 
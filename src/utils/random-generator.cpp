@@ -1,21 +1,48 @@
 #include "random-generator.h"
 
+#include <random>
+
 namespace tfe::utils {
 
-    std::mt19937& RandomGenerator::getEngine() {
-        static std::random_device rd;
-        static std::mt19937 engine(rd());
-        return engine;
+    RandomGenerator::RandomGenerator() : RandomGenerator(randomSeed()) {}
+
+    RandomGenerator::RandomGenerator(const uint64_t seed) { this->seed(seed); }
+
+    void RandomGenerator::seed(uint64_t seed) {
+        // SplitMix64 expands the seed into a well-mixed, never all-zero state
+        for (uint64_t& word : s_) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
     }
 
-    int RandomGenerator::getInt(const int min, const int max) {
-        std::uniform_int_distribution<int> dist(min, max);
-        return dist(getEngine());
+    void RandomGenerator::jump() {
+        static constexpr uint64_t JUMP[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (const uint64_t word : JUMP) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (uint64_t{1} << b)) {
+                    s0 ^= s_[0];
+                    s1 ^= s_[1];
+                    s2 ^= s_[2];
+                    s3 ^= s_[3];
+                }
+                next();
+            }
+        }
+        s_[0] = s0;
+        s_[1] = s1;
+        s_[2] = s2;
+        s_[3] = s3;
     }
 
-    bool RandomGenerator::getBool(const double probability) {
-        std::bernoulli_distribution dist(probability);
-        return dist(getEngine());
+    uint64_t RandomGenerator::randomSeed() {
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) ^ rd();
     }
 
-}  // namespace tfe::utils
\ No newline at end of file
+}  // namespace tfe::utils
@@ -1,20 +1,61 @@
 #pragma once
-#include <random>
+#include <cstdint>
 
 namespace tfe::utils {  // tfe = twenty-four-eight
 
-    // A static utility class for generating random numbers.
+    // A small, fast, seedable random generator (xoshiro256**).
+    // Each Board owns one, so games are independent, thread-safe and reproducible from their seed.
     class RandomGenerator {
     public:
-        // Returns a random integer in the inclusive range [min, max].
-        static int getInt(int min, int max);
+        using result_type = uint64_t;
+
+        // Seeds from std::random_device.
+        RandomGenerator();
+
+        // Seeds deterministically; equal seeds produce identical streams.
+        explicit RandomGenerator(uint64_t seed);
+
+        // Restarts the stream from a new seed.
+        void seed(uint64_t seed);
+
+        // Advances the stream by 2^128 draws. Calling jump() k times on copies of one generator
+        // yields non-overlapping streams, e.g. one per self-play thread.
+        void jump();
+
+        // Returns a non-deterministic seed (std::random_device).
+        static uint64_t randomSeed();
+
+        // Returns the next raw 64-bit value.
+        uint64_t next() {
+            const uint64_t result = rotl(s_[1] * 5, 7) * 9;
+            const uint64_t t = s_[1] << 17;
+            s_[2] ^= s_[0];
+            s_[3] ^= s_[1];
+            s_[1] ^= s_[2];
+            s_[0] ^= s_[3];
+            s_[2] ^= t;
+            s_[3] = rotl(s_[3], 45);
+            return result;
+        }
+
+        // Returns a random integer in the inclusive range [min, max] (multiply-shift, no division).
+        int getInt(const int min, const int max) {
+            const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+            return min + static_cast<int>(((next() >> 32) * range) >> 32);
+        }
 
         // Returns true with a given probability (from 0.0 to 1.0).
-        static bool getBool(double probability);
+        bool getBool(const double probability) { return static_cast<double>(next() >> 11) * 0x1.0p-53 < probability; }
+
+        // UniformRandomBitGenerator interface, so <random> distributions also accept it
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT64_MAX; }
+        result_type operator()() { return next(); }
 
     private:
-        // Provides access to the singleton random number engine.
-        static std::mt19937& getEngine();
+        static uint64_t rotl(const uint64_t x, const int k) { return (x << k) | (x >> (64 - k)); }
+
+        uint64_t s_[4];
     };
 
-}  // namespace tfe::utils
\ No newline at end of file
+}  // namespace tfe::utils
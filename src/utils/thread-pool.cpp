@@ -0,0 +1,105 @@
+#include "thread-pool.h"
+
+#include <map>
+
+namespace tfe::utils {
+
+    namespace {
+        // Which pool (if any) the current thread works for, and its deque
+        thread_local const ThreadPool* tlsPool = nullptr;
+        thread_local int tlsIndex = -1;
+    }  // namespace
+
+    ThreadPool::ThreadPool(const int workers) {
+        const int count = workers > 0 ? workers : 0;
+        for (int i = 0; i <= count; ++i) queues_.push_back(std::make_unique<Queue>());
+        workers_.reserve(count);
+        for (int i = 0; i < count; ++i) workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(sleepMutex_);
+            stop_.store(true);
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    int ThreadPool::hardwareThreads() {
+        const unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : static_cast<int>(n);
+    }
+
+    ThreadPool& ThreadPool::shared(const int threads) {
+        static std::mutex mutex;
+        static std::map<int, std::unique_ptr<ThreadPool>> pools;
+        const std::lock_guard lock(mutex);
+        auto& pool = pools[threads];
+        if (!pool) pool = std::make_unique<ThreadPool>(threads - 1);  // The calling thread is the last worker
+        return *pool;
+    }
+
+    int ThreadPool::currentIndex() const { return tlsPool == this ? tlsIndex : static_cast<int>(workers_.size()); }
+
+    void ThreadPool::submit(Task task) {
+        Queue& queue = *queues_[currentIndex()];
+        {
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        queued_.fetch_add(1);
+        // Sleepers register before re-checking queued_, so either they see this task or we see them
+        if (sleeping_.load() > 0) {
+            std::lock_guard lock(sleepMutex_);
+            wake_.notify_one();
+        }
+    }
+
+    bool ThreadPool::popOwn(const int index, Task& task) {
+        Queue& queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool ThreadPool::steal(const int thief, Task& task) {
+        const int n = static_cast<int>(queues_.size());
+        for (int k = 1; k < n; ++k) {
+            Queue& queue = *queues_[(thief + k) % n];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::runPendingTask() {
+        if (queued_.load(std::memory_order_acquire) == 0) return false;
+        const int index = currentIndex();
+        Task task;
+        if (!popOwn(index, task) && !steal(index, task)) return false;
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(const int index) {
+        tlsPool = this;
+        tlsIndex = index;
+        while (true) {
+            if (runPendingTask()) continue;
+            std::unique_lock lock(sleepMutex_);
+            sleeping_.fetch_add(1);
+            wake_.wait(lock, [this] { return stop_.load() || queued_.load() > 0; });
+            sleeping_.fetch_sub(1);
+            if (stop_.load()) return;
+        }
+    }
+
+}  // namespace tfe::utils
@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tfe::utils {
+
+    /**
+     * @class ThreadPool
+     * @brief Work-stealing pool for fork-join tasks.
+     *
+     * Every worker owns a deque: it pushes and pops its own tasks at the back (newest first,
+     * cache-warm subtrees) and, when empty, steals the oldest task from the front of another
+     * deque (the biggest pieces of work). Threads outside the pool push to a shared queue.
+     * Waiting is never blocking: TaskGroup::wait() runs queued tasks until its own are done,
+     * so nested fork-join cannot deadlock.
+     */
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        /**
+         * @brief Starts @p workers background threads (0 is allowed: tasks then run in wait()).
+         */
+        explicit ThreadPool(int workers);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        int workerCount() const { return static_cast<int>(workers_.size()); }
+
+        // Queues a task on the calling worker's deque (or the shared queue from outside the pool).
+        void submit(Task task);
+
+        // Runs one queued task on the calling thread if any is available (own deque first, then steals).
+        bool runPendingTask();
+
+        // std::thread::hardware_concurrency(), at least 1.
+        static int hardwareThreads();
+
+        /**
+         * @brief Process-wide pool for searches running on @p threads threads (threads - 1 workers plus the caller).
+         *
+         * One pool per thread count, created on first use and kept until exit, so threads are not respawned every
+         * move and searches with different thread counts can run side by side without tearing down each other's pool.
+         */
+        static ThreadPool& shared(int threads);
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void workerLoop(int index);
+        bool popOwn(int index, Task& task);
+        bool steal(int thief, Task& task);
+        int currentIndex() const;
+
+        // queues_[0..workers-1] belong to the workers, the last one is shared by outside threads
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> workers_;
+
+        std::atomic<int> queued_{0};
+        std::atomic<int> sleeping_{0};
+        std::atomic<bool> stop_{false};
+        std::mutex sleepMutex_;
+        std::condition_variable wake_;
+    };
+
+    /**
+     * @class TaskGroup
+     * @brief Forks tasks onto a ThreadPool and joins them; the waiting thread helps run queued work.
+     */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+        ~TaskGroup() { wait(); }
+
+        template <typename F>
+        void run(F&& f) {
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            pool_.submit([this, fn = std::forward<F>(f)]() mutable {
+                fn();
+                pending_.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        void wait() {
+            while (pending_.load(std::memory_order_acquire) != 0) {
+                if (!pool_.runPendingTask()) std::this_thread::yield();
+            }
+        }
+
+    private:
+        ThreadPool& pool_;
+        std::atomic<int> pending_{0};
+    };
+
+}  // namespace tfe::utils
@@ -0,0 +1,435 @@
+#include "core/ai_solver.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/leaf_eval.h"
+#include "core/move_kernel.h"
+#include "core/transposition_table.h"
+#include "utils/thread-pool.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    // Sums 1..n by recursive fork-join, like the search splits subtrees
+    long long forkSum(tfe::utils::ThreadPool& pool, const int lo, const int hi) {
+        if (hi - lo < 64) {
+            long long s = 0;
+            for (int i = lo; i < hi; ++i) s += i;
+            return s;
+        }
+        const int mid = (lo + hi) / 2;
+        long long left = 0, right = 0;
+        tfe::utils::TaskGroup group(pool);
+        group.run([&] { left = forkSum(pool, lo, mid); });
+        group.run([&] { right = forkSum(pool, mid, hi); });
+        group.wait();
+        return left + right;
+    }
+
+}  // namespace
+
+TEST(ThreadPoolTest, NestedForkJoin) {
+    for (const int workers : {0, 1, 3}) {
+        tfe::utils::ThreadPool pool(workers);
+        EXPECT_EQ(forkSum(pool, 0, 100000), 100000LL * 99999 / 2) << workers << " workers";
+    }
+}
+
+TEST(ThreadPoolTest, SharedPoolPerThreadCount) {
+    tfe::utils::ThreadPool& two = tfe::utils::ThreadPool::shared(2);
+    EXPECT_EQ(two.workerCount(), 1);
+    EXPECT_EQ(tfe::utils::ThreadPool::shared(4).workerCount(), 3);
+    // Asking for another thread count must not replace a pool a running search may hold
+    EXPECT_EQ(&tfe::utils::ThreadPool::shared(2), &two);
+}
+
+TEST(AISolverTest, SearchesWithDifferentThreadCountsRunSideBySide) {
+    std::atomic<int> legal{0};
+    std::vector<std::thread> searches;
+    for (const int threads : {2, 3, 4}) {
+        searches.emplace_back([&legal, threads] {
+            SearchOptions options;
+            options.timeLimitMs = 0;
+            options.threads = threads;
+            Board board(4, static_cast<uint64_t>(threads));
+            for (int i = 0; i < 5 && !board.isGameOver(); ++i) {
+                const Direction dir = AISolver::findBestMove(board, 2, options);
+                legal += (board.legalMoves() >> static_cast<int>(dir)) & 1;
+                board.move(dir);
+            }
+        });
+    }
+    for (auto& search : searches) search.join();
+    EXPECT_EQ(legal.load(), 15);
+}
+
+TEST(AISolverTest, ConcurrentSearchesCountOnlyTheirOwnNodes) {
+    // Searches on the same thread count share one pool, so a thread waiting inside one search runs the tasks of
+    // the others. A depth-1 search on a cold table visits a fixed number of nodes: two of them run over and over
+    // next to a deep search, and none may pick up nodes counted by another search.
+    SearchOptions options;
+    options.timeLimitMs = 0;
+    options.threads = 3;
+    options.reuseTable = false;
+    SearchLimits shallow;
+    shallow.maxDepth = 1;
+    SearchLimits deep;
+    deep.maxDepth = 4;
+
+    Board boards[3] = {Board(4, 21), Board(4, 22), Board(4, 23)};
+    uint64_t expected[2];
+    for (Board& board : boards) {
+        for (int move = 0; move < 30; ++move) board.move(AISolver::findBestMove(board, 1));
+    }
+    for (int i = 0; i < 2; ++i) {
+        SearchStats stats;
+        AISolver::findBestMove(boards[i], shallow, options, &stats);
+        expected[i] = stats.nodes;
+    }
+
+    std::atomic<bool> done{false};
+    std::thread deepSearches([&] {
+        for (int run = 0; run < 10; ++run) AISolver::findBestMove(boards[2], deep, options);
+        done = true;
+    });
+    int runs[2] = {}, wrong[2] = {};
+    std::thread other([&] {
+        while (!done) {
+            SearchStats stats;
+            AISolver::findBestMove(boards[1], shallow, options, &stats);
+            wrong[1] += stats.nodes != expected[1];
+            ++runs[1];
+        }
+    });
+    while (!done) {
+        SearchStats stats;
+        AISolver::findBestMove(boards[0], shallow, options, &stats);
+        wrong[0] += stats.nodes != expected[0];
+        ++runs[0];
+    }
+    deepSearches.join();
+    other.join();
+    for (int i = 0; i < 2; ++i) EXPECT_EQ(wrong[i], 0) << runs[i] << " searches of board " << i;
+}
+
+TEST(AISolverTest, ParallelSearchMatchesSequential) {
+    // The table only answers the probed depth and sums are taken in the sequential order, so table timing cannot
+    // change a value until the probability cutoff (0.1^3 stays above it) makes a transposition path-dependent
+    SearchOptions sequential;
+    sequential.timeLimitMs = 0;
+    sequential.reuseTable = false;
+    SearchOptions parallel = sequential;
+    parallel.threads = 4;
+
+    Board board(4, 2024);
+    for (int i = 0; i < 60 && !board.isGameOver(); ++i) {
+        const Direction seq = AISolver::findBestMove(board, 3, sequential);
+        EXPECT_EQ(AISolver::findBestMove(board, 3, parallel), seq) << i;
+        board.move(seq);
+    }
+}
+
+TEST(AISolverTest, SymmetricKeysPickLegalMoves) {
+    SearchOptions symmetric;
+    symmetric.timeLimitMs = 0;
+    symmetric.reuseTable = false;
+    symmetric.symmetricKeys = true;
+
+    // Agreement with plain keys is a near-tie question, measured by tt_reuse_bench
+    Board board(4, 77);
+    for (int i = 0; i < 20 && !board.isGameOver(); ++i) {
+        const Direction move = AISolver::findBestMove(board, 3, symmetric);
+        ASSERT_TRUE((board.legalMoves() >> static_cast<int>(move)) & 1) << i;
+        board.move(move);
+    }
+}
+
+TEST(AISolverTest, DeadlineAbortsDeepIteration) {
+    Board board(4, 5);
+    for (int i = 0; i < 30; ++i) board.move(AISolver::findBestMove(board, 1));
+
+    for (const int threads : {1, 2}) {
+        SearchOptions options;
+        options.threads = threads;
+        const auto start = std::chrono::steady_clock::now();
+        // Depth 20 would take hours without the in-tree abort
+        const Direction dir = AISolver::findBestMove(board, SearchLimits::withTimeBudget(30, 20), options);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_LT(elapsed, std::chrono::milliseconds(250)) << threads << " threads";
+        EXPECT_TRUE((board.legalMoves() >> static_cast<int>(dir)) & 1);
+    }
+}
+
+TEST(AISolverTest, NodeBudgetIsDeterministic) {
+    SearchOptions options;
+    options.reuseTable = false;
+    SearchLimits limits;
+    limits.maxDepth = 12;
+
+    Board board(4, 6);
+    for (int i = 0; i < 20 && !board.isGameOver(); ++i) {
+        limits.maxNodes = 20000;
+        const Direction a = AISolver::findBestMove(board, limits, options);
+        const Direction b = AISolver::findBestMove(board, limits, options);
+        EXPECT_EQ(a, b);
+        EXPECT_TRUE((board.legalMoves() >> static_cast<int>(a)) & 1);
+
+        // Less than one check interval of budget: still a legal move
+        limits.maxNodes = 1;
+        const Direction c = AISolver::findBestMove(board, limits, options);
+        EXPECT_TRUE((board.legalMoves() >> static_cast<int>(c)) & 1);
+        board.move(a);
+    }
+}
+
+TEST(AISolverTest, PlanSearchSpendsMoreOnCrowdedBoards) {
+    Board open(4, 1), crowded(4, 1);
+    open.loadState({0x0000000000000121ULL, 0});       // 13 empty cells
+    crowded.loadState({0x3456A98712345670ULL, 0});    // 1 empty cell, 10 distinct tiles
+
+    const SearchLimits easy = AISolver::planSearch(open, 100);
+    const SearchLimits hard = AISolver::planSearch(crowded, 100);
+    EXPECT_LT(easy.maxDepth, hard.maxDepth);
+    EXPECT_GT(easy.probCutoff, hard.probCutoff);
+    EXPECT_LT(easy.deadline, hard.deadline);
+
+    // No budget: no deadline, whatever the position
+    EXPECT_EQ(AISolver::planSearch(crowded, 0).deadline, SearchLimits::Clock::time_point::max());
+}
+
+TEST(AISolverTest, SearchStatsAddUp) {
+    SearchOptions options;
+    options.reuseTable = false;
+    SearchLimits limits;
+    limits.maxDepth = 3;
+
+    Board board(4, 8);
+    for (int i = 0; i < 10; ++i) board.move(AISolver::findBestMove(board, 1));
+
+    SearchStats stats;
+    AISolver::findBestMove(board, limits, options, &stats);
+    ASSERT_EQ(stats.iterations.size(), 3u);
+    EXPECT_EQ(stats.depthReached, 3);
+    EXPECT_FALSE(stats.aborted);
+    uint64_t iterationNodes = 0;
+    for (const auto& iteration : stats.iterations) {
+        EXPECT_TRUE(iteration.completed);
+        iterationNodes += iteration.nodes;
+    }
+    EXPECT_EQ(iterationNodes, stats.nodes);
+    EXPECT_EQ(stats.ttBytes, TranspositionTable::instance().sizeBytes());
+
+#if defined(TFE_SEARCH_STATS)
+    // Every chance node probes the table once; leaves are neither chance nor max nodes
+    EXPECT_EQ(stats.chanceNodes, stats.ttProbes);
+    EXPECT_LE(stats.ttHits + stats.ttStores, stats.ttProbes);
+    EXPECT_LT(stats.chanceNodes + stats.maxNodes + stats.probCutoffs, stats.nodes);
+    EXPECT_GT(stats.maxNodes, 0u);
+#else
+    EXPECT_EQ(stats.chanceNodes, 0u);
+    EXPECT_EQ(stats.ttProbes, 0u);
+#endif
+}
+
+TEST(AISolverTest, SparseSamplingIsReproducible) {
+    SearchOptions exact;
+    exact.reuseTable = false;
+    SearchOptions sparse = exact;
+    sparse.sampleSpawns = 2;
+    sparse.sampleFromPly = 1;
+    sparse.sampleSeed = 42;
+    SearchOptions sparseParallel = sparse;
+    sparseParallel.threads = 3;
+    SearchLimits limits;
+    limits.maxDepth = 3;
+
+    Board board(4, 9);
+    for (int i = 0; i < 15 && !board.isGameOver(); ++i) {
+        SearchStats full, a, b;
+        AISolver::findBestMove(board, limits, exact, &full);
+        const Direction first = AISolver::findBestMove(board, limits, sparse, &a);
+        const Direction second = AISolver::findBestMove(board, limits, sparse, &b);
+        const Direction parallel = AISolver::findBestMove(board, limits, sparseParallel);
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(a.nodes, b.nodes);
+        EXPECT_LE(a.nodes, full.nodes);
+        // Same samples on every thread; a tree this small never fills the table and has no probability cutoff,
+        // so table timing cannot change a value
+        EXPECT_EQ(parallel, first) << i;
+        board.move(first);
+    }
+}
+
+TEST(AISolverTest, SparseEntriesStayOutOfLaterSearches) {
+    Board board(4, 12);
+    for (int i = 0; i < 20; ++i) board.move(AISolver::findBestMove(board, 1));
+    SearchLimits limits;
+    limits.maxDepth = 3;
+    SearchOptions sparse;
+    sparse.sampleSpawns = 2;
+    sparse.sampleFromPly = 1;
+
+    // A reusing search right after a sparse one must not find the sampled estimates
+    AISolver::findBestMove(board, limits, sparse);
+    SearchStats reused;
+    const Direction reusedMove = AISolver::findBestMove(board, limits, {}, &reused);
+
+    SearchOptions cold;
+    cold.reuseTable = false;
+    SearchStats fresh;
+    const Direction freshMove = AISolver::findBestMove(board, limits, cold, &fresh);
+    EXPECT_EQ(reusedMove, freshMove);
+    EXPECT_EQ(reused.nodes, fresh.nodes);
+}
+
+TEST(AISolverTest, BatchedLeavesMatchScalar) {
+    tfe::utils::RandomGenerator rng(19);
+    std::vector<Bitboard> boards(1000);
+    for (Bitboard& board : boards) {
+        for (int cell = 0; cell < 16; ++cell) {
+            if (rng.getBool(0.7)) board |= static_cast<Bitboard>(rng.getInt(1, 13)) << (4 * cell);
+        }
+    }
+    // Odd count: the SIMD kernel's tail runs through the scalar path
+    std::vector<float> scores(boards.size());
+    evaluateLeaves(boards.data(), scores.data(), 999);
+    for (std::size_t i = 0; i < 999; ++i) ASSERT_EQ(scores[i], evaluateLeaf(boards[i])) << i;
+}
+
+TEST(AISolverTest, QuantizedTablesTrackFloat) {
+    tfe::utils::RandomGenerator rng(23);
+    std::vector<Bitboard> boards(1000);
+    for (Bitboard& board : boards) {
+        for (int cell = 0; cell < 16; ++cell) {
+            if (rng.getBool(0.7)) board |= static_cast<Bitboard>(rng.getInt(1, 13)) << (4 * cell);
+        }
+    }
+    std::vector<float> reference(boards.size());
+    for (std::size_t i = 0; i < boards.size(); ++i) reference[i] = evaluateLeafFloat(boards[i]);
+
+    for (const WeightPrecision precision : {WeightPrecision::Int16, WeightPrecision::Float16}) {
+        LookupTable::setWeightPrecision(precision);
+        std::vector<float> scores(boards.size());
+        evaluateLeaves(boards.data(), scores.data(), 999);
+        for (std::size_t i = 0; i < 999; ++i) {
+            ASSERT_EQ(scores[i], evaluateLeaf(boards[i])) << i;
+            // Int16: half a step per entry; Float16: ~2^-11 relative per entry
+            EXPECT_NEAR(scores[i], reference[i], 8 * LookupTable::heuristicScale + 2e-3f * std::abs(reference[i])) << i;
+        }
+    }
+    // Leaf values stay within the bound above; how often that changes the chosen move is measured by quantized_eval_bench
+    LookupTable::setWeightPrecision(WeightPrecision::Float32);
+}
+
+TEST(AISolverTest, ReweightingDropsTableEntries) {
+    Board board(4, 31);
+    for (int i = 0; i < 20; ++i) board.move(AISolver::findBestMove(board, 1));
+    SearchLimits limits;
+    limits.maxDepth = 3;
+
+    // Warm the table under float weights, then requantize: the reusing search must start cold
+    AISolver::findBestMove(board, limits);
+    LookupTable::setWeightPrecision(WeightPrecision::Int16);
+    SearchStats reused;
+    const Direction reusedMove = AISolver::findBestMove(board, limits, {}, &reused);
+
+    SearchOptions cold;
+    cold.reuseTable = false;
+    SearchStats fresh;
+    const Direction freshMove = AISolver::findBestMove(board, limits, cold, &fresh);
+    LookupTable::setWeightPrecision(WeightPrecision::Float32);
+
+    EXPECT_EQ(reusedMove, freshMove);
+    EXPECT_EQ(reused.nodes, fresh.nodes);
+}
+
+TEST(AISolverTest, OwnTableLeavesSharedTableAlone) {
+    TranspositionTable& shared = TranspositionTable::instance();
+    constexpr Bitboard sentinel = 0x1234000000000000ULL;
+    shared.put(sentinel, 7, 42.0f);
+
+    // A clearing search on its own table fills that one and never touches the shared entries
+    TranspositionTable own(1);
+    SearchOptions options;
+    options.timeLimitMs = 0;
+    options.reuseTable = false;
+    options.table = &own;
+    Board board(4, 3);
+    SearchStats stats;
+    AISolver::findBestMove(board, SearchLimits{}, options, &stats);
+    EXPECT_EQ(stats.ttBytes, own.sizeBytes());
+
+    float score = 0;
+    ASSERT_TRUE(shared.get(sentinel, 7, score));
+    EXPECT_EQ(score, 42.0f);
+    const MoveSet moves = computeMoves(board.getState().board);
+    int ownEntries = 0;
+    for (int dir = 0; dir < 4; ++dir) ownEntries += ((moves.legal >> dir) & 1) && own.get(moves.after[dir], 4, score);
+    EXPECT_EQ(ownEntries, std::popcount(moves.legal));
+}
+
+TEST(AISolverTest, StarPruningKeepsDecisions) {
+    // The bound Star1 relies on: no leaf scores above 6 rows without a bigger tile plus the 2 lines through its top tile
+    tfe::utils::RandomGenerator rng(31);
+    for (int i = 0; i < 1000; ++i) {
+        Bitboard board = 0;
+        int top = 0;
+        for (int cell = 0; cell < 16; ++cell) {
+            const int rank = rng.getBool(0.7) ? rng.getInt(1, 15) : 0;
+            board |= static_cast<Bitboard>(rank) << (4 * cell);
+            top = std::max(top, rank);
+        }
+        const float any = *std::max_element(LookupTable::heuristicRowMax, LookupTable::heuristicRowMax + top + 1);
+        ASSERT_LE(evaluateLeaf(board), 6 * any + 2 * LookupTable::heuristicRowMax[top]) << std::hex << board;
+    }
+
+    SearchOptions plain;
+    plain.reuseTable = false;
+    SearchOptions star = plain;
+    star.starPruning = true;
+
+    // Every 5th position of whole seeded games (openings cut little: their values sit close to the bound)
+    std::vector<Board> positions;
+    for (uint64_t seed = 1; positions.size() < 400; ++seed) {
+        Board board(4, seed);
+        for (int move = 0; !board.isGameOver() && positions.size() < 400; ++move) {
+            if (move % 5 == 0) positions.push_back(board);
+            board.move(AISolver::findBestMove(board, 1));
+        }
+    }
+
+    // Exact values are the plain search's, so every decision is too
+    for (const auto& [depth, count] : {std::pair{3, 400}, std::pair{4, 150}}) {
+        SearchLimits limits;
+        limits.maxDepth = depth;
+        int agree = 0;
+        uint64_t plainNodes = 0, starNodes = 0, cutoffs = 0;
+        for (int i = 0; i < count; ++i) {
+            SearchStats a, b;
+            const Direction expected = AISolver::findBestMove(positions[i], limits, plain, &a);
+            agree += AISolver::findBestMove(positions[i], limits, star, &b) == expected;
+            EXPECT_EQ(b.iterations.size(), a.iterations.size());
+            EXPECT_EQ(a.starCutoffs, 0u);
+            plainNodes += a.nodes;
+            starNodes += b.nodes;
+            cutoffs += b.starCutoffs;
+        }
+        EXPECT_EQ(agree, count) << "depth " << depth;
+        EXPECT_LT(starNodes, plainNodes) << "depth " << depth;
+#if defined(TFE_SEARCH_STATS)
+        EXPECT_GT(cutoffs, 0u);
+#else
+        EXPECT_EQ(cutoffs, 0u);
+#endif
+    }
+}
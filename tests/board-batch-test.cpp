@@ -0,0 +1,88 @@
+#include "core/board_batch.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "core/board.h"
+
+using namespace tfe::core;
+
+// Random position with a realistic mix of empty cells and tiles
+static Bitboard randomBoard(std::mt19937_64& rng) {
+    Bitboard board = 0;
+    for (int i = 0; i < 16; ++i) {
+        const int roll = static_cast<int>(rng() % 16);
+        if (roll < 6) continue;
+        board |= static_cast<Bitboard>(roll % 10 + 1) << (i * 4);
+    }
+    return board;
+}
+
+// Batch kernel must agree with Board::move (minus the spawned tile) for every direction.
+TEST(BoardBatchTest, MoveKernelMatchesBoard) {
+    std::mt19937_64 rng(42);
+    constexpr std::size_t count = 1027;  // Not a multiple of 4 to exercise the scalar tail
+    std::vector<Bitboard> in(count), out(count);
+    std::vector<Direction> dirs(count);
+    std::vector<int> rewards(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        in[i] = randomBoard(rng);
+        dirs[i] = static_cast<Direction>(rng() % 4);
+    }
+
+    BoardBatch::moveBoards(in.data(), dirs.data(), out.data(), rewards.data(), count);
+
+    Board board(4);
+    for (std::size_t i = 0; i < count; ++i) {
+        board.loadState({in[i], 0});
+        const bool moved = board.move(dirs[i]);
+        ASSERT_EQ(moved, out[i] != in[i]) << "board " << i;
+        if (!moved) continue;
+
+        EXPECT_EQ(board.getScore(), rewards[i]) << "board " << i;
+        // The only difference must be one freshly spawned 2 or 4 on an empty cell
+        const Bitboard diff = board.getState().board ^ out[i];
+        int changedCells = 0;
+        for (int c = 0; c < 16; ++c) {
+            const Tile spawned = (diff >> (c * 4)) & 0xF;
+            if (spawned == 0) continue;
+            changedCells++;
+            EXPECT_EQ((out[i] >> (c * 4)) & 0xF, 0u);
+            EXPECT_TRUE(spawned == 1 || spawned == 2);
+        }
+        EXPECT_EQ(changedCells, 1) << "board " << i;
+    }
+}
+
+TEST(BoardBatchTest, StepUpdatesScoresAndDoneFlags) {
+    BoardBatch batch(3);
+
+    // Game 0: [2, 2, 0, 0] -> Left merges into 4
+    batch.setBoard(0, 0x0011, 0);
+    // Game 1: checkerboard, no moves left
+    Bitboard stuck = 0;
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c) stuck |= static_cast<Bitboard>(((r + c) % 2 == 0) ? 1 : 2) << (r * 16 + c * 4);
+    batch.setBoard(1, stuck, 100);
+    // Game 2: [4, 0, 0, 0] -> Left does nothing
+    batch.setBoard(2, 0x0002, 8);
+
+    EXPECT_FALSE(batch.isDone(0));
+    EXPECT_TRUE(batch.isDone(1));
+
+    const std::vector<Direction> dirs(3, Direction::Left);
+    EXPECT_EQ(batch.step(dirs), 1u);
+
+    EXPECT_EQ(batch.getBoard(0) & 0xF, 2u);
+    EXPECT_EQ(batch.getScore(0), 4);
+    EXPECT_EQ(batch.getBoard(1), stuck);
+    EXPECT_EQ(batch.getScore(1), 100);
+    EXPECT_EQ(batch.getBoard(2), 0x0002u);
+    EXPECT_EQ(batch.getScore(2), 8);
+
+    EXPECT_EQ(batch.resetFinished(), 1u);
+    EXPECT_FALSE(batch.isDone(1));
+    EXPECT_EQ(batch.getScore(1), 0);
+}
@@ -2,6 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
+#include "core/bitboard.h"
+#include "core/lookup_table.h"
+#include "core/move_kernel.h"
+#include "utils/random-generator.h"
+
 using namespace tfe::core;
 
 void clearBoard(Board& board) {
@@ -191,4 +198,208 @@ TEST(BoardTest, ResetBoard) {
     // The old (0,0) tile was 10 (1024), now it's highly probable to be 0 or 1/2.
     // Ensure it's no longer 10
     EXPECT_NE(board.getTile(0, 0), 10);
-}
\ No newline at end of file
+}
+
+// Records every event fired by an ObservableBoard
+struct RecordingObserver final : tfe::IGameObserver {
+    int spawns = 0, merges = 0, moves = 0, gameOvers = 0, resets = 0;
+    void onTileSpawn(int, int, int) override { spawns++; }
+    void onTileMerge(int, int, int) override { merges++; }
+    void onTileMove(int, int, int, int, int) override { moves++; }
+    void onGameOver() override { gameOvers++; }
+    void onGameReset() override { resets++; }
+};
+
+// 6. The observable board reports moves/merges for changed rows only
+TEST(BoardTest, ObservableBoardEvents) {
+    ObservableBoard board(4);
+    RecordingObserver observer;
+    board.addObserver(&observer);
+
+    // Row 0: [2, 2, 0, 0], Row 1: [4, 0, 0, 0] (already packed left)
+    board.loadState({0x0000000000020011ULL, 0});
+    EXPECT_EQ(observer.resets, 1);
+
+    EXPECT_TRUE(board.move(Direction::Left));
+    EXPECT_EQ(observer.moves, 1);   // (0,1) slides onto (0,0)
+    EXPECT_EQ(observer.merges, 1);  // 2 + 2 -> 4 at (0,0)
+    EXPECT_EQ(observer.spawns, 1);
+
+    board.removeObserver(&observer);
+    board.move(Direction::Right);
+    EXPECT_EQ(observer.spawns, 1);
+}
+
+// 7. Column tables must match the transpose + row table formulation for every column
+TEST(BoardTest, ColumnTablesMatchTranspose) {
+    for (int col = 0; col < 65536; ++col) {
+        ASSERT_EQ(LookupTable::moveUpCol[col], transpose64(LookupTable::moveLeftTable[col]));
+        ASSERT_EQ(LookupTable::moveDownCol[col], transpose64(LookupTable::moveRightTable[col]));
+    }
+}
+
+// 8. The all-directions kernel agrees with the single-direction kernel and Board::move
+TEST(BoardTest, MoveKernelAllDirections) {
+    Board board(4);
+    // Row 0: [2, 2, 4, 0], Row 1: [2, 0, 0, 0]
+    const Bitboard start = 0x0000000000010211ULL;
+    const MoveSet moves = computeMoves(start);
+
+    for (int d = 0; d < 4; ++d) {
+        const auto dir = static_cast<Direction>(d);
+        int reward = 0;
+        EXPECT_EQ(moves.after[d], moveBoard(start, dir, reward));
+        EXPECT_EQ(moves.reward[d], reward);
+
+        board.loadState({start, 0});
+        EXPECT_EQ(isLegal(moves, dir), board.move(dir));
+        EXPECT_EQ(board.getScore(), isLegal(moves, dir) ? reward : 0);
+    }
+
+    EXPECT_EQ(moves.reward[static_cast<int>(Direction::Left)], 4);  // 2 + 2
+    EXPECT_EQ(moves.reward[static_cast<int>(Direction::Up)], 4);    // column 0: 2 over 2
+    EXPECT_EQ(moves.legal, 0b1111);
+}
+
+// 9. Packed and split table layouts must produce identical moves and rewards
+TEST(BoardTest, PackedTablesMatchSplit) {
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (int n = 0; n < 20000; ++n) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const Bitboard board = seed & 0x7777777777777777ULL;  // tiles up to 2^7, plenty of merges
+        const MoveSet split = computeMovesSplit(board);
+        const MoveSet packed = computeMovesPacked(board);
+        ASSERT_EQ(split.legal, packed.legal);
+        for (int d = 0; d < 4; ++d) {
+            ASSERT_EQ(split.after[d], packed.after[d]);
+            ASSERT_EQ(split.reward[d], packed.reward[d]);
+
+            int reward = 0;
+            ASSERT_EQ(moveBoardPacked(board, static_cast<Direction>(d), reward), split.after[d]);
+            ASSERT_EQ(reward, split.reward[d]);
+        }
+    }
+}
+
+// 10. SWAR empty-cell mask, count and k-th selection
+TEST(BoardTest, EmptyMaskSelection) {
+    // Cells 0, 2 and 15 hold tiles (including a 2^15 tile, all bits set)
+    const Bitboard board = 0xF000000000000201ULL;
+    const uint64_t mask = emptyMask(board);
+    EXPECT_EQ(countEmpty(board), 13);
+    EXPECT_EQ(mask & 0xFFF, 0x010u);  // Only cell 1 of the low three is empty
+
+    int expectedShift = -4;
+    for (int k = 0; k < 13; ++k) {
+        do {
+            expectedShift += 4;
+        } while ((board >> expectedShift) & 0xF);
+        EXPECT_EQ(selectEmptyCell(mask, k), expectedShift);
+    }
+    EXPECT_EQ(countEmpty(0), 16);
+}
+
+// 11. Boards with the same seed replay the same spawns; other seeds diverge
+TEST(BoardTest, SeededBoardsReplayIdentically) {
+    const Direction moves[] = {Direction::Left, Direction::Up, Direction::Right, Direction::Down};
+
+    Board a(4, 12345);
+    Board b(4, 12345);
+    Board c(4, 54321);
+    bool diverged = a.getState().board != c.getState().board;
+    for (int i = 0; i < 200; ++i) {
+        const Direction dir = moves[i % 4];
+        a.move(dir);
+        b.move(dir);
+        c.move(dir);
+        ASSERT_EQ(a.getState().board, b.getState().board);
+        ASSERT_EQ(a.getScore(), b.getScore());
+        diverged |= a.getState().board != c.getState().board;
+    }
+    EXPECT_TRUE(diverged);
+
+    // Reseeding restarts the stream
+    a.seed(7);
+    b.seed(7);
+    a.reset();
+    b.reset();
+    EXPECT_EQ(a.getState().board, b.getState().board);
+}
+
+// 12. jump() moves the generator to an independent stream; getInt stays in range
+TEST(BoardTest, RandomGeneratorJumpStreams) {
+    tfe::utils::RandomGenerator base(42);
+    tfe::utils::RandomGenerator same(42);
+    tfe::utils::RandomGenerator jumped(42);
+    jumped.jump();
+
+    int equalToSame = 0, equalToJumped = 0;
+    for (int i = 0; i < 64; ++i) {
+        const uint64_t v = base.next();
+        equalToSame += v == same.next();
+        equalToJumped += v == jumped.next();
+    }
+    EXPECT_EQ(equalToSame, 64);
+    EXPECT_EQ(equalToJumped, 0);
+
+    for (int i = 0; i < 1000; ++i) {
+        const int v = base.getInt(3, 9);
+        EXPECT_GE(v, 3);
+        EXPECT_LE(v, 9);
+    }
+}
+
+// 13. SWAR legal-move mask agrees with the all-directions kernel
+TEST(BoardTest, LegalMovesMatchesKernel) {
+    tfe::utils::RandomGenerator rng(2048);
+    for (int i = 0; i < 200000; ++i) {
+        // Mix dense low tiles (many merges) with sparse boards (many slides)
+        Bitboard board = 0;
+        const int maxTile = (i % 3 == 0) ? 3 : 15;
+        for (int cell = 0; cell < 16; ++cell) {
+            const int v = rng.getInt(0, maxTile);
+            if (i % 2 == 0 || rng.getBool(0.5)) board |= static_cast<Bitboard>(v) << (cell * 4);
+        }
+        ASSERT_EQ(legalMoves(board), computeMoves(board).legal) << std::hex << board;
+    }
+    EXPECT_EQ(legalMoves(0), 0);
+    EXPECT_EQ(legalMoves(0x0001), (1 << static_cast<int>(Direction::Down)) | (1 << static_cast<int>(Direction::Right)));
+}
+
+// 14. Every rotation/reflection of a board has the same canonical form
+TEST(BoardTest, CanonicalBoardIsSymmetryInvariant) {
+    tfe::utils::RandomGenerator rng(8);
+    for (int i = 0; i < 20000; ++i) {
+        Bitboard board = 0;
+        for (int cell = 0; cell < 16; ++cell) board |= static_cast<Bitboard>(rng.getInt(0, 15)) << (cell * 4);
+
+        const Bitboard h = flipHorizontal(board);
+        const Bitboard t = transpose64(board);
+        const Bitboard th = flipHorizontal(t);
+        const Bitboard symmetries[8] = {board, h, flipVertical(board), flipVertical(h), t, th, flipVertical(t), flipVertical(th)};
+        const Bitboard canonical = canonicalBoard(board);
+        for (const Bitboard s : symmetries) ASSERT_EQ(canonicalBoard(s), canonical);
+        ASSERT_EQ(flipHorizontal(h), board);
+        ASSERT_EQ(flipVertical(flipVertical(board)), board);
+    }
+    // Row 0 = [1, 2, 3, 4]: mirrored rows and row order
+    EXPECT_EQ(flipHorizontal(0x4321), 0x1234u);
+    EXPECT_EQ(flipVertical(0x4321), 0x4321ULL << 48);
+}
+
+// 15. Symmetric transposition keys rely on this; only float rounding (summation order, relative
+// to the 200000 loss-penalty offset) may differ
+TEST(BoardTest, HeuristicTableIsMirrorSymmetric) {
+    for (int row = 0; row < 65536; ++row) {
+        const float a = LookupTable::defaultHeuristicTable[row];
+        const float b = LookupTable::defaultHeuristicTable[reverseRow(static_cast<Row>(row))];
+        ASSERT_NEAR(a, b, 1e-6f * std::max(std::abs(a), 200000.0f)) << row;
+    }
+}
+
+// 16. Board is the 4x4 engine only; SizedBoard<N> covers the other sizes
+TEST(BoardTest, RejectsOtherSizes) {
+    EXPECT_THROW(Board(5, 1), std::invalid_argument);
+    EXPECT_THROW(Board(3), std::invalid_argument);
+    EXPECT_EQ(Board(4, 1).getSize(), 4);
+}
@@ -0,0 +1,95 @@
+#include "core/mcts_solver.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "core/ai_solver.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    MCTSOptions playoutBudget(const uint64_t playouts, const int threads = 1) {
+        MCTSOptions options;
+        options.timeLimitMs = 0;
+        options.maxPlayouts = playouts;
+        options.threads = threads;
+        options.seed = 42;
+        return options;
+    }
+
+}  // namespace
+
+TEST(MCTSSolverTest, PlaysLegalMovesAndCountsPlayouts) {
+    Board board(4, 3);
+    const MCTSOptions options = playoutBudget(300);
+    for (int i = 0; i < 40 && !board.isGameOver(); ++i) {
+        MCTSStats stats;
+        const Direction dir = MCTSSolver::findBestMove(board, options, &stats);
+        ASSERT_TRUE((board.legalMoves() >> static_cast<int>(dir)) & 1);
+        EXPECT_EQ(stats.playouts, 300u);
+        uint64_t rootVisits = 0;
+        for (const uint64_t v : stats.rootVisits) rootVisits += v;
+        EXPECT_EQ(rootVisits, stats.playouts);
+        EXPECT_LE(stats.nodes, options.arenaNodes);
+        board.move(dir);
+    }
+}
+
+TEST(MCTSSolverTest, PlayoutBudgetIsDeterministic) {
+    Board board(4, 8);
+    for (int i = 0; i < 15; ++i) board.move(MCTSSolver::findBestMove(board, playoutBudget(100)));
+
+    for (const int threads : {1, 3}) {
+        MCTSStats a, b;
+        const Direction first = MCTSSolver::findBestMove(board, playoutBudget(600, threads), &a);
+        const Direction second = MCTSSolver::findBestMove(board, playoutBudget(600, threads), &b);
+        EXPECT_EQ(first, second) << threads << " threads";
+        EXPECT_EQ(a.nodes, b.nodes) << threads << " threads";
+        for (int dir = 0; dir < 4; ++dir) EXPECT_EQ(a.rootVisits[dir], b.rootVisits[dir]) << threads << " threads";
+    }
+}
+
+TEST(MCTSSolverTest, FullArenaKeepsRollingOut) {
+    Board board(4, 11);
+    MCTSOptions options = playoutBudget(500);
+    options.arenaNodes = 16;
+    MCTSStats stats;
+    const Direction dir = MCTSSolver::findBestMove(board, options, &stats);
+    EXPECT_TRUE((board.legalMoves() >> static_cast<int>(dir)) & 1);
+    EXPECT_EQ(stats.playouts, 500u);
+    EXPECT_LE(stats.nodes, 16u);
+}
+
+TEST(MCTSSolverTest, TimeLimitStopsSearch) {
+    Board board(4, 5);
+    for (const int threads : {1, 2}) {
+        MCTSOptions options;
+        options.timeLimitMs = 30;
+        options.threads = threads;
+        const auto start = std::chrono::steady_clock::now();
+        MCTSStats stats;
+        const Direction dir = MCTSSolver::findBestMove(board, options, &stats);
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(250)) << threads << " threads";
+        EXPECT_GT(stats.playouts, 0u);
+        EXPECT_TRUE((board.legalMoves() >> static_cast<int>(dir)) & 1);
+    }
+}
+
+TEST(MCTSSolverTest, RunsBesideExpectimaxWithOtherThreadCount) {
+    // Both solvers draw from ThreadPool::shared; a second thread count must not tear down the first pool
+    Board board(4, 6);
+    SearchOptions expectimax;
+    expectimax.timeLimitMs = 0;
+    expectimax.threads = 3;
+    Direction searched = Direction::Up;
+    std::thread other([&] { searched = AISolver::findBestMove(board, 3, expectimax); });
+    for (int i = 0; i < 5; ++i) {
+        const Direction dir = MCTSSolver::findBestMove(board, playoutBudget(400, 2));
+        EXPECT_TRUE((board.legalMoves() >> static_cast<int>(dir)) & 1);
+    }
+    other.join();
+    EXPECT_TRUE((board.legalMoves() >> static_cast<int>(searched)) & 1);
+}
@@ -0,0 +1,110 @@
+#include "core/ntuple_network.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "core/ai_solver.h"
+#include "core/bitboard.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    // Deterministic non-trivial weights: one update per training board
+    void seedWeights(NTupleNetwork& network) {
+        Board board(4, 31);
+        for (int i = 0; i < 200 && !board.isGameOver(); ++i) {
+            const Bitboard state = board.getState().board;
+            network.update(state, static_cast<float>(i % 7) - 3.0f);
+            board.move(AISolver::findBestMove(board, 1));
+        }
+    }
+
+}  // namespace
+
+TEST(NTupleNetworkTest, PackedIndexFollowsCellOrder) {
+    const NTupleNetwork network({{5, 0, 2}}, false);
+    // Cells 0, 2 and 5 hold exponents 3, 7 and 11; the index packs them in ascending cell order
+    const Bitboard board = 0x3ULL | (0x7ULL << 8) | (0xBULL << 20) | (0x4ULL << 4) | (0x9ULL << 60);
+    EXPECT_EQ(network.tupleIndex(0, board), 0xB73u);
+    EXPECT_EQ(network.weightCount(), 4096u);
+}
+
+TEST(NTupleNetworkTest, SymmetricSamplingIsInvariant) {
+    NTupleNetwork network(NTupleNetwork::standardTuples(), true);
+    seedWeights(network);
+
+    Board board(4, 12);
+    for (int i = 0; i < 50 && !board.isGameOver(); ++i) {
+        const Bitboard b = board.getState().board;
+        const float value = network.evaluate(b);
+        EXPECT_NEAR(network.evaluate(flipHorizontal(b)), value, 1e-3f);
+        EXPECT_NEAR(network.evaluate(flipVertical(b)), value, 1e-3f);
+        EXPECT_NEAR(network.evaluate(transpose64(b)), value, 1e-3f);
+        board.move(AISolver::findBestMove(board, 1));
+    }
+}
+
+TEST(NTupleNetworkTest, UpdateShiftsEvaluation) {
+    NTupleNetwork network(NTupleNetwork::standardTuples(), false);
+    const Bitboard board = 0x0123456789ABCDEFULL;
+    network.update(board, 0.5f);
+    // Without symmetric sampling every tuple reads exactly one weight
+    EXPECT_FLOAT_EQ(network.evaluate(board), 0.5f * static_cast<float>(network.tupleCount()));
+}
+
+TEST(NTupleNetworkTest, SaveLoadRoundTrip) {
+    NTupleNetwork network({{0, 1, 2, 3}, {0, 4, 8, 12}, {0, 1, 4, 5}}, true);
+    seedWeights(network);
+    const std::string path = ::testing::TempDir() + "ntuple_roundtrip.bin";
+    ASSERT_TRUE(network.save(path.c_str()));
+
+    NTupleNetwork loaded({{0}}, false);
+    ASSERT_TRUE(NTupleNetwork::load(path.c_str(), loaded));
+    EXPECT_EQ(loaded.tupleCount(), 3u);
+    EXPECT_TRUE(loaded.symmetric());
+    for (const Bitboard b : {0x0ULL, 0x1234000000002101ULL, 0xFEDCBA9876543210ULL}) {
+        EXPECT_EQ(loaded.evaluate(b), network.evaluate(b));
+    }
+
+    // Truncated file: the target keeps its previous contents
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite("NTN1", 1, 4, file);
+    std::fclose(file);
+    EXPECT_FALSE(NTupleNetwork::load(path.c_str(), loaded));
+    EXPECT_EQ(loaded.tupleCount(), 3u);
+
+    // A header declaring 64 8-tuples (a terabyte of weights) without them fails like any other bad file
+    file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    const auto writeU32 = [&](const uint32_t v) { std::fwrite(&v, sizeof(v), 1, file); };
+    std::fwrite("NTN1", 1, 4, file);
+    writeU32(64);
+    writeU32(1);
+    for (uint32_t t = 0; t < 64; ++t) {
+        writeU32(8);
+        for (uint32_t cell = 0; cell < 8; ++cell) writeU32(cell + t % 8);
+    }
+    std::fclose(file);
+    EXPECT_FALSE(NTupleNetwork::load(path.c_str(), loaded));
+    EXPECT_EQ(loaded.tupleCount(), 3u);
+    std::remove(path.c_str());
+}
+
+TEST(NTupleNetworkTest, SolverUsesPluggedEvaluator) {
+    // Values only the exponent of the bottom-right corner
+    NTupleNetwork corner({{15}}, false);
+    for (int e = 1; e < 16; ++e) corner.update(static_cast<Bitboard>(e) << 60, 100.0f * static_cast<float>(e));
+
+    SearchOptions options;
+    options.timeLimitMs = 0;
+    options.evaluator = &corner;
+    Board board;
+    board.loadState({0x8001ULL, 0});  // 256 in the top-right corner, 2 in the top-left
+    EXPECT_EQ(AISolver::findBestMove(board, 1, options), Direction::Down);
+    EXPECT_EQ(AISolver::findBestMove(board, 2, options), Direction::Down);
+}
@@ -0,0 +1,144 @@
+#include "core/opening_book.h"
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstdio>
+#include <string>
+
+#include "core/ai_solver.h"
+#include "core/move_kernel.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    // Early-game boards from a seeded game played by a shallow search
+    std::vector<Bitboard> earlyBoards(const uint64_t seed, const int moves) {
+        std::vector<Bitboard> boards;
+        Board board(4, seed);
+        SearchOptions options;
+        options.timeLimitMs = 0;
+        for (int i = 0; i < moves && !board.isGameOver(); ++i) {
+            boards.push_back(board.getState().board);
+            board.move(AISolver::findBestMove(board, 1, options));
+        }
+        return boards;
+    }
+
+    Board boardOf(const Bitboard bits) {
+        Board board(4, 1);
+        board.loadState({bits, 0});
+        return board;
+    }
+
+}  // namespace
+
+TEST(OpeningBookTest, ProbeMapsTheMoveOntoEveryOrientation) {
+    const std::vector<Bitboard> boards = earlyBoards(5, 30);
+    std::vector<OpeningBook::Entry> entries;
+    for (const Bitboard board : boards) {
+        const uint8_t legal = legalMoves(board);
+        entries.push_back({board, static_cast<Direction>(std::countr_zero(legal))});
+    }
+    const std::string path = ::testing::TempDir() + "opening_book_probe.bin";
+    const std::size_t written = OpeningBook::write(path.c_str(), entries);
+    ASSERT_GT(written, 0u);
+
+    OpeningBook book;
+    ASSERT_TRUE(book.open(path.c_str()));
+    EXPECT_EQ(book.size(), written);
+
+    for (const OpeningBook::Entry& entry : entries) {
+        const Bitboard expected = computeMoves(entry.board).after[static_cast<int>(entry.move)];
+        Bitboard orientations[8], afterstates[8];
+        symmetries(entry.board, orientations);
+        symmetries(expected, afterstates);
+        for (int s = 0; s < 8; ++s) {
+            const auto move = book.probe(orientations[s]);
+            ASSERT_TRUE(move.has_value()) << std::hex << orientations[s];
+            const MoveSet moves = computeMoves(orientations[s]);
+            ASSERT_TRUE(isLegal(moves, *move));
+            // Same decision up to symmetry: the afterstates are orientations of each other
+            EXPECT_EQ(canonicalBoard(moves.after[static_cast<int>(*move)]), canonicalBoard(afterstates[s]));
+        }
+    }
+    EXPECT_FALSE(book.probe(0x0000000000001111ULL).has_value());  // Four 2s in a row: never in an opening
+
+    book.close();
+    EXPECT_FALSE(book.isOpen());
+    EXPECT_FALSE(book.probe(entries.front().board).has_value());
+    std::remove(path.c_str());
+}
+
+TEST(OpeningBookTest, WriteCanonicalizesAndDropsIllegalMoves) {
+    const Bitboard board = 0x0000000000000012ULL;  // 4 2 . . on the top row
+    const std::string path = ::testing::TempDir() + "opening_book_dedup.bin";
+    const std::vector<OpeningBook::Entry> entries = {
+        {board, Direction::Down},
+        {flipHorizontal(board), Direction::Left},  // Same class: the first entry wins
+        {0x0000000000000001ULL, Direction::Up},    // Lone tile in the corner cannot move up
+    };
+    EXPECT_EQ(OpeningBook::write(path.c_str(), entries), 1u);
+
+    OpeningBook book;
+    ASSERT_TRUE(book.open(path.c_str()));
+    EXPECT_EQ(book.probe(board), Direction::Down);
+    EXPECT_EQ(book.probe(flipHorizontal(board)), Direction::Down);
+    EXPECT_EQ(book.probe(transpose64(board)), Direction::Right);
+    EXPECT_FALSE(book.probe(0x0000000000000001ULL).has_value());
+    std::remove(path.c_str());
+}
+
+TEST(OpeningBookTest, RejectsMissingAndMalformedFiles) {
+    OpeningBook book;
+    EXPECT_FALSE(book.open((::testing::TempDir() + "no_such_book.bin").c_str()));
+    EXPECT_FALSE(book.isOpen());
+
+    const std::string path = ::testing::TempDir() + "opening_book_bad.bin";
+    ASSERT_EQ(OpeningBook::write(path.c_str(), {{0x12ULL, Direction::Down}, {0x123ULL, Direction::Down}}), 2u);
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, 8, SEEK_SET);
+    const uint64_t count = 3;  // Claims more entries than the file holds
+    std::fwrite(&count, sizeof(count), 1, file);
+    std::fclose(file);
+    EXPECT_FALSE(book.open(path.c_str()));
+    EXPECT_FALSE(book.isOpen());
+    std::remove(path.c_str());
+}
+
+TEST(OpeningBookTest, SolverAnswersHitsWithoutSearching) {
+    const Bitboard bits = earlyBoards(9, 6).back();
+    const Board board = boardOf(bits);
+    SearchLimits limits;
+    limits.maxDepth = 2;
+    SearchStats stats;
+    const Direction searched = AISolver::findBestMove(board, limits, {}, &stats);
+    EXPECT_FALSE(stats.bookHit);
+
+    // Store another legal move so a hit is distinguishable from a search
+    const uint8_t others = legalMoves(bits) & ~(1u << static_cast<int>(searched));
+    ASSERT_NE(others, 0);
+    const auto stored = static_cast<Direction>(std::countr_zero(others));
+    const std::string path = ::testing::TempDir() + "opening_book_solver.bin";
+    ASSERT_EQ(OpeningBook::write(path.c_str(), {{bits, stored}}), 1u);
+    OpeningBook book;
+    ASSERT_TRUE(book.open(path.c_str()));
+
+    SearchOptions options;
+    options.book = &book;
+    EXPECT_EQ(AISolver::findBestMove(board, limits, options, &stats), stored);
+    EXPECT_TRUE(stats.bookHit);
+    EXPECT_EQ(stats.nodes, 0u);
+    EXPECT_TRUE(stats.iterations.empty());
+
+    // A miss searches as if there were no book
+    Board other = board;
+    other.move(searched);
+    const Direction expected = AISolver::findBestMove(other, limits, {}, nullptr);
+    EXPECT_EQ(AISolver::findBestMove(other, limits, options, &stats), expected);
+    EXPECT_FALSE(stats.bookHit);
+    EXPECT_GT(stats.nodes, 0u);
+    std::remove(path.c_str());
+}
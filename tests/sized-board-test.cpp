@@ -0,0 +1,143 @@
+#include "core/sized_board.h"
+
+#include <gtest/gtest.h>
+
+#include "core/ai_solver.h"
+#include "core/move_kernel.h"
+
+using namespace tfe::core;
+
+namespace {
+
+    template <int N>
+    typename SizedLayout<N>::Storage randomBoard(tfe::utils::RandomGenerator& rng, const int maxTile) {
+        typename SizedLayout<N>::Storage board{};
+        for (int r = 0; r < N; ++r)
+            for (int c = 0; c < N; ++c)
+                if (rng.getBool(0.7)) SizedLayout<N>::setTile(board, r, c, static_cast<Tile>(rng.getInt(1, maxTile)));
+        return board;
+    }
+
+    template <int N>
+    typename SizedLayout<N>::Storage transpose(const typename SizedLayout<N>::Storage& board) {
+        typename SizedLayout<N>::Storage out{};
+        for (int r = 0; r < N; ++r)
+            for (int c = 0; c < N; ++c) SizedLayout<N>::setTile(out, c, r, SizedLayout<N>::getTile(board, r, c));
+        return out;
+    }
+
+    // Up must be Left on the transposed board and Right/Down the mirrored moves, for every kernel
+    template <int N>
+    void checkDirectionsConsistent() {
+        tfe::utils::RandomGenerator rng(N);
+        for (int i = 0; i < 2000; ++i) {
+            const auto board = randomBoard<N>(rng, i % 2 ? 3 : 12);
+            int upReward, leftReward, downReward, rightReward;
+            const auto up = moveSized<N>(board, Direction::Up, upReward);
+            const auto down = moveSized<N>(board, Direction::Down, downReward);
+            const auto leftT = moveSized<N>(transpose<N>(board), Direction::Left, leftReward);
+            const auto rightT = moveSized<N>(transpose<N>(board), Direction::Right, rightReward);
+            ASSERT_EQ(transpose<N>(up), leftT);
+            ASSERT_EQ(transpose<N>(down), rightT);
+            ASSERT_EQ(upReward, leftReward);
+            ASSERT_EQ(downReward, rightReward);
+
+            uint8_t legal = 0;
+            for (int d = 0; d < 4; ++d) {
+                int reward;
+                legal |= static_cast<uint8_t>((moveSized<N>(board, static_cast<Direction>(d), reward) != board) << d);
+            }
+            ASSERT_EQ(legalMovesSized<N>(board), legal);
+        }
+    }
+
+}  // namespace
+
+TEST(SizedBoardTest, SlideLineMatchesRowTable) {
+    for (uint32_t row = 0; row < 65536; ++row) {
+        int reward;
+        // Tiles of 15 overflow the nibble in both implementations; keep them out of the comparison
+        bool hasMax = false;
+        for (int i = 0; i < 4; ++i) hasMax |= ((row >> (i * 4)) & 0xF) == 0xF;
+        if (hasMax) continue;
+        ASSERT_EQ(slideLineLeft<4>(row, reward), LookupTable::moveLeftTable[row]);
+        ASSERT_EQ(reward, LookupTable::scoreTable[row]);
+    }
+}
+
+TEST(SizedBoardTest, LineExamples) {
+    int reward;
+    // [2, 2, 2] -> [4, 2, 0]
+    EXPECT_EQ(slideLineLeft<3>(0x111, reward), 0x012u);
+    EXPECT_EQ(reward, 4);
+    // [0, 4, 4, 8, 8, 0] -> [8, 16, 0, 0, 0, 0]
+    EXPECT_EQ(slideLineLeft<6>(0x033220, reward), 0x43u);
+    EXPECT_EQ(reward, 24);
+    // 5x5 table agrees with the reference kernel
+    EXPECT_EQ(LineKernel<5>::moveLeft(0x21102, reward), slideLineLeft<5>(0x21102, reward));
+}
+
+TEST(SizedBoardTest, DirectionsConsistent) {
+    checkDirectionsConsistent<3>();
+    checkDirectionsConsistent<4>();
+    checkDirectionsConsistent<5>();
+    checkDirectionsConsistent<6>();
+}
+
+TEST(SizedBoardTest, Board4MatchesBoard) {
+    tfe::utils::RandomGenerator rng(4);
+    for (int i = 0; i < 1000; ++i) {
+        const Bitboard board = randomBoard<4>(rng, 12);
+        const MoveSet moves = computeMoves(board);
+        for (int d = 0; d < 4; ++d) {
+            int reward;
+            ASSERT_EQ(moveSized<4>(board, static_cast<Direction>(d), reward), moves.after[d]);
+            ASSERT_EQ(reward, moves.reward[d]);
+        }
+    }
+}
+
+TEST(SizedBoardTest, SeededGamesReplayAndFinish) {
+    Board5 a(99), b(99);
+    int moves = 0;
+    while (!a.isGameOver() && moves < 100000) {
+        const auto dir = static_cast<Direction>(moves % 4);
+        a.move(dir);
+        b.move(dir);
+        ++moves;
+    }
+    EXPECT_TRUE(a.isGameOver());
+    EXPECT_EQ(a.getState(), b.getState());
+    EXPECT_EQ(a.getScore(), b.getScore());
+    EXPECT_GT(a.getScore(), 0);
+}
+
+TEST(SizedBoardTest, SolverReturnsLegalMove) {
+    Board3 b3(3);
+    Board6 b6(6);
+    for (int i = 0; i < 20 && !b3.isGameOver(); ++i) {
+        const Direction dir = AISolver::findBestMove(b3, 2);
+        EXPECT_TRUE((b3.legalMoves() >> static_cast<int>(dir)) & 1);
+        b3.move(dir);
+    }
+    const Direction dir = AISolver::findBestMove(b6, 1);
+    EXPECT_TRUE((b6.legalMoves() >> static_cast<int>(dir)) & 1);
+}
+
+TEST(SizedBoardTest, SolverStopsAtLimits) {
+    Board6 board(6);
+    // A depth no 6x6 search finishes: the node budget ends it and a legal move still comes back
+    SearchLimits limits;
+    limits.maxDepth = 8;
+    limits.maxNodes = 20000;
+    const auto start = SearchLimits::Clock::now();
+    Direction dir = AISolver::findBestMove(board, limits);
+    EXPECT_TRUE((board.legalMoves() >> static_cast<int>(dir)) & 1);
+
+    // Same with a deadline that has already passed
+    SearchOptions options;
+    options.timeLimitMs = 1;
+    dir = AISolver::findBestMove(board, 8, options);
+    EXPECT_TRUE((board.legalMoves() >> static_cast<int>(dir)) & 1);
+    EXPECT_LT(std::chrono::duration<double>(SearchLimits::Clock::now() - start).count(), 5.0);
+}
@@ -0,0 +1,129 @@
+#include "core/transposition_table.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace tfe::core;
+
+namespace {
+
+    // Every writer stores this score for a board, so any value read back can be checked
+    float scoreFor(const Bitboard board) { return static_cast<float>(board % 100003); }
+
+}  // namespace
+
+TEST(TranspositionTableTest, StoresAndRespectsDepth) {
+    TranspositionTable& tt = TranspositionTable::instance();
+    tt.resize(1);
+    float score = 0;
+    EXPECT_FALSE(tt.get(0x1234, 1, score));
+
+    tt.put(0x1234, 3, 42.5f);
+    EXPECT_TRUE(tt.get(0x1234, 3, score));
+    EXPECT_EQ(score, 42.5f);
+    // Only the depth it was searched at: values of other depths differ
+    EXPECT_FALSE(tt.get(0x1234, 2, score));
+    EXPECT_FALSE(tt.get(0x1234, 4, score));
+
+    // A shallower result never overwrites a deeper one
+    tt.put(0x1234, 1, 7.0f);
+    EXPECT_TRUE(tt.get(0x1234, 3, score));
+    EXPECT_EQ(score, 42.5f);
+
+    tt.clear();
+    EXPECT_FALSE(tt.get(0x1234, 1, score));
+    tt.resize(TranspositionTable::DEFAULT_SIZE_MB);
+}
+
+TEST(TranspositionTableTest, UpperBoundsStaySeparate) {
+    TranspositionTable& tt = TranspositionTable::instance();
+    tt.resize(1);
+    float score = 0;
+
+    // A bound is invisible to get() and, like an exact entry, only answers its own depth
+    tt.putUpperBound(0x1234, 3, 10.0f);
+    EXPECT_FALSE(tt.get(0x1234, 3, score));
+    EXPECT_TRUE(tt.getUpperBound(0x1234, 3, score));
+    EXPECT_EQ(score, 10.0f);
+    EXPECT_FALSE(tt.getUpperBound(0x1234, 2, score));
+    EXPECT_FALSE(tt.getUpperBound(0x1234, 4, score));
+
+    // An exact result as deep supersedes the bound, and a bound never replaces an exact result as deep
+    tt.put(0x1234, 3, 8.0f);
+    EXPECT_FALSE(tt.getUpperBound(0x1234, 3, score));
+    tt.putUpperBound(0x1234, 3, 5.0f);
+    EXPECT_TRUE(tt.get(0x1234, 3, score));
+    EXPECT_EQ(score, 8.0f);
+    EXPECT_FALSE(tt.getUpperBound(0x1234, 3, score));
+
+    // A bound of another depth sits beside the exact result without evicting it
+    tt.putUpperBound(0x1234, 2, 5.0f);
+    EXPECT_TRUE(tt.get(0x1234, 3, score));
+    EXPECT_EQ(score, 8.0f);
+    EXPECT_TRUE(tt.getUpperBound(0x1234, 2, score));
+    EXPECT_EQ(score, 5.0f);
+
+    tt.clear();
+    tt.resize(TranspositionTable::DEFAULT_SIZE_MB);
+}
+
+TEST(TranspositionTableTest, MemoryIsFixed) {
+    TranspositionTable& tt = TranspositionTable::instance();
+    tt.resize(1);
+    EXPECT_EQ(tt.sizeBytes(), std::size_t{1} << 20);
+    EXPECT_EQ(tt.capacity(), (std::size_t{1} << 20) / 16);
+
+    // Far more boards than slots: the table keeps its size and deep entries survive shallow ones
+    for (Bitboard b = 1; b <= 500000; ++b) tt.put(b, 1, scoreFor(b));
+    tt.put(0xABCDEF, 9, 1.0f);
+    for (Bitboard b = 500001; b <= 600000; ++b) tt.put(b, 1, scoreFor(b));
+    EXPECT_EQ(tt.sizeBytes(), std::size_t{1} << 20);
+    float score = 0;
+    EXPECT_TRUE(tt.get(0xABCDEF, 9, score));
+    tt.resize(TranspositionTable::DEFAULT_SIZE_MB);
+}
+
+TEST(TranspositionTableTest, GenerationsCarryOverAndAge) {
+    TranspositionTable& tt = TranspositionTable::instance();
+    tt.resize(0);  // Two buckets of four slots
+    float score = 0;
+
+    // Same generation: a deep entry outlives a flood of shallow ones
+    tt.put(0x777, 6, 3.0f);
+    for (Bitboard b = 1; b <= 100; ++b) tt.put(b * 0x1111, 2, 0.0f);
+    EXPECT_TRUE(tt.get(0x777, 6, score));
+
+    // Entries survive a new search
+    tt.newSearch();
+    EXPECT_TRUE(tt.get(0x777, 6, score));
+    EXPECT_EQ(score, 3.0f);
+
+    // Once stale, it is evicted before current depth-2 entries
+    tt.newSearch();
+    for (Bitboard b = 1; b <= 100; ++b) tt.put(b * 0x1111, 2, 0.0f);
+    EXPECT_FALSE(tt.get(0x777, 6, score));
+    tt.resize(TranspositionTable::DEFAULT_SIZE_MB);
+}
+
+TEST(TranspositionTableTest, ConcurrentReadersNeverSeeTornEntries) {
+    TranspositionTable& tt = TranspositionTable::instance();
+    tt.resize(1);  // Small table: heavy contention on the same buckets
+
+    std::vector<std::thread> threads;
+    std::atomic<int> wrong{0};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (Bitboard i = 0; i < 200000; ++i) {
+                const Bitboard board = (i * 4 + t) * 0x9E3779B97F4A7C15ULL | 1;
+                tt.put(board, 1 + static_cast<int>(i % 5), scoreFor(board));
+                const Bitboard probe = ((i / 2) * 4 + (t + 1) % 4) * 0x9E3779B97F4A7C15ULL | 1;
+                if (float score; tt.get(probe, 1, score) && score != scoreFor(probe)) wrong++;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(wrong.load(), 0);
+    tt.resize(TranspositionTable::DEFAULT_SIZE_MB);
+}